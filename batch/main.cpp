@@ -0,0 +1,77 @@
+// Solves a range of deals on a pool of threads, streaming one line per deal
+// as soon as it is finished:
+//
+//   seed  status  moves  nodes  seconds
+//
+// Usage: batch FIRST LAST [THREADS] [SECONDS] [NODES]
+//
+// FIRST and LAST are Microsoft FreeCell deal numbers.
+//
+// THREADS defaults to one per hardware thread, SECONDS is the time budget
+// per deal (default 10) and NODES the node budget per deal (default 2000000).
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GameADT.h"
+#include "SolverADT.h"
+
+
+static const char * statusName(SolveStatusT s) {
+    switch (s) {
+        case Solved:
+            return "solved";
+        case Unsolvable:
+            return "unsolvable";
+        case NodeLimit:
+            return "node-limit";
+        case TimeLimit:
+            return "timeout";
+    }
+    return "";
+}
+
+
+int main(int argc, char ** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " FIRST LAST [THREADS] [SECONDS] [NODES]" << std::endl;
+        return 1;
+    }
+
+    unsigned long long first = std::strtoull(argv[1], 0, 10);
+    unsigned long long last = std::strtoull(argv[2], 0, 10);
+    unsigned int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    SolverConfigT config;
+    config.maxSeconds = argc > 4 ? std::atof(argv[4]) : 10;
+    config.maxNodes = argc > 5 ? std::strtoul(argv[5], 0, 10) : 2000000;
+
+    std::atomic<unsigned long long> next(first);
+    std::mutex out;
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.push_back(std::thread([&]() {
+            // Each thread keeps one solver, so its buffers are allocated once
+            // and reused for every deal it takes.
+            SolverT solver(config);
+            for (unsigned long long seed = next++; seed <= last; seed = next++) {
+                SolveResultT r = solver.solve(GameT(seed, MicrosoftDeal));
+                std::lock_guard<std::mutex> guard(out);
+                std::cout << seed << '\t' << statusName(r.status) << '\t'
+                          << r.moves.size() << '\t' << r.nodes << '\t'
+                          << r.seconds << std::endl;
+            }
+        }));
+    }
+    for (std::thread &t : pool) {
+        t.join();
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * \file bench.h
+ * \author agent <agent@local>
+ * \brief Provides a minimal harness for timing operations and counting the
+ *   heap allocations they perform.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+
+/**
+ * \brief Returns the number of calls to the global operator new so far.
+ */
+unsigned long long allocationCount();
+
+/**
+ * \brief Returns true if the benchmark named `name` was selected on the
+ *   command line. Every benchmark is selected when no filter is given.
+ */
+bool benchSelected(const char * name);
+
+/**
+ * \brief Forces the compiler to materialize a value which would otherwise be
+ *   optimized away.
+ */
+template <class T>
+void keep(const T & v) {
+    static volatile const void * sink;
+    sink = &v;
+    (void)sink;
+}
+
+/**
+ * \brief Runs `f` `iterations` times and reports nanoseconds and heap
+ *   allocations per call.
+ */
+template <class F>
+void benchmark(const char * name, unsigned long iterations, F f) {
+    if (!benchSelected(name)) {
+        return;
+    }
+    unsigned long long allocs = allocationCount();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long n = 0; n < iterations; n++) {
+        f();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    allocs = allocationCount() - allocs;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << std::left << std::setw(48) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << ns / iterations << " ns/op"
+              << std::setprecision(2)
+              << std::setw(10) << static_cast<double>(allocs) / iterations << " allocs/op"
+              << std::endl;
+}
+
+void benchStackADT();
+void benchCardADT();
+void benchGameADT();
+void benchDealADT();
+void benchMoveLogADT();
+void benchNotationADT();
+void benchSolverADT();
+void benchFortyThievesADT();
+void benchBatchGameADT();
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * \file benchBatchGameADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of the BatchGameT queries and moves over many boards,
+ *   against the same work done board by board with GameT.
+ */
+#include <vector>
+
+#include "bench.h"
+#include "BatchGameADT.h"
+#include "GameADT.h"
+#include "MoveADT.h"
+
+
+void benchBatchGameADT() {
+    const unsigned int boards = 1024;
+    std::vector<GameT> games;
+    BatchGameT batch(boards);
+    for (unsigned int b = 0; b < boards; b++) {
+        games.push_back(GameT(b + 1));
+        batch.load(b, games[b]);
+    }
+
+    // Each pair queries the same 1024 boards, one GameT at a time and then
+    // as a batch.
+    benchmark("GameT::hasWon x1024", 10000, [&]() {
+        unsigned int won = 0;
+        for (const GameT &g : games) {
+            won += g.hasWon();
+        }
+        keep(won);
+    });
+    std::vector<unsigned char> won;
+    benchmark("BatchGameT::hasWon (1024 boards)", 10000, [&]() {
+        batch.hasWon(won);
+        keep(won[0]);
+    });
+
+    benchmark("GameT::foundationHeights x1024", 10000, [&]() {
+        unsigned int home = 0;
+        for (const GameT &g : games) {
+            home += heightsTotal(g.foundationHeights());
+        }
+        keep(home);
+    });
+    std::vector<FoundationHeightsT> heights;
+    benchmark("BatchGameT::foundationHeights (1024 boards)", 10000, [&]() {
+        batch.foundationHeights(heights);
+        keep(heights[0]);
+    });
+    std::vector<unsigned char> counts;
+    benchmark("BatchGameT::homeCounts (1024 boards)", 10000, [&]() {
+        batch.homeCounts(counts);
+        keep(counts[0]);
+    });
+
+    MoveBuffer buffer;
+    benchmark("GameT::generateMoves x1024", 1000, [&]() {
+        unsigned int n = 0;
+        for (const GameT &g : games) {
+            g.generateMoves(buffer);
+            n += buffer.size();
+        }
+        keep(n);
+    });
+    std::vector<uint32_t> masks;
+    benchmark("BatchGameT::moveMasks (1024 boards)", 1000, [&]() {
+        batch.moveMasks(masks);
+        keep(masks[0]);
+    });
+
+    // The first valid move of each board, and the moves reversing them.
+    batch.moveMasks(masks);
+    std::vector<MoveT> moves(boards, MoveT(0, 0, 0));
+    std::vector<MoveT> reverse(boards, MoveT(0, 0, 0));
+    for (unsigned int b = 0; b < boards; b++) {
+        for (unsigned int s = 0; s < GameT::Columns; s++) {
+            uint32_t mask = masks[s * boards + b];
+            if (mask != 0 && moves[b].count() == 0) {
+                unsigned int d = __builtin_ctz(mask);
+                moves[b] = MoveT(s, d);
+                reverse[b] = MoveT(d, s);
+            }
+        }
+    }
+    benchmark("BatchGameT::applyMoves x2 (1024 boards)", 10000, [&]() {
+        batch.applyMoves(moves);
+        batch.applyMoves(reverse);
+        keep(batch.top(0, 0));
+    });
+}
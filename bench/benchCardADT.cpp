@@ -0,0 +1,37 @@
+/**
+ * \file benchCardADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of the CardT accessors and comparisons.
+ */
+#include "bench.h"
+#include "CardADT.h"
+
+
+void benchCardADT() {
+    CardT deck[52];
+    for (unsigned int k = 0; k < 52; k++) {
+        deck[k] = CardT(static_cast<SuitT>(k / 13), static_cast<RankT>(k % 13 + 1));
+    }
+
+    benchmark("CardT(suit, rank) (52 cards)", 100000, [&]() {
+        unsigned int sum = 0;
+        for (unsigned int k = 0; k < 52; k++) {
+            sum += CardT(static_cast<SuitT>(k / 13), static_cast<RankT>(k % 13 + 1)).code();
+        }
+        keep(sum);
+    });
+    benchmark("CardT::isRed (52 cards)", 100000, [&]() {
+        unsigned int red = 0;
+        for (CardT c : deck) {
+            red += c.isRed();
+        }
+        keep(red);
+    });
+    benchmark("CardT::suit + rank (52 cards)", 100000, [&]() {
+        unsigned int sum = 0;
+        for (CardT c : deck) {
+            sum += c.suit() + c.rank();
+        }
+        keep(sum);
+    });
+}
@@ -0,0 +1,54 @@
+/**
+ * \file benchDealADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of dealing by seed, of snapshots and of bulk dealing
+ *   with DealArenaT.
+ */
+#include "bench.h"
+#include "DealADT.h"
+#include "GameADT.h"
+
+
+void benchDealADT() {
+    uint64_t seed = 0;
+    benchmark("GameT() (random_device seeded)", 100000, [&]() {
+        GameT g;
+        keep(g);
+    });
+    benchmark("GameT(seed, MicrosoftDeal)", 100000, [&]() {
+        GameT g(++seed);
+        keep(g);
+    });
+    benchmark("GameT(seed, FastDeal)", 100000, [&]() {
+        GameT g(++seed, FastDeal);
+        keep(g);
+    });
+    benchmark("fastDeck", 100000, [&]() {
+        keep(fastDeck(++seed));
+    });
+
+    GameT g(1);
+    SnapshotT snap = g.snapshot();
+    benchmark("GameT::snapshot", 1000000, [&]() {
+        keep(g.snapshot());
+    });
+    benchmark("GameT(SnapshotViewT)", 100000, [&]() {
+        GameT h((SnapshotViewT(snap)));
+        keep(h);
+    });
+    benchmark("SnapshotViewT::top over all columns", 1000000, [&]() {
+        SnapshotViewT v(snap);
+        unsigned int sum = 0;
+        for (unsigned int col = 0; col < 8; col++) {
+            sum += v.top(col);
+        }
+        keep(sum);
+    });
+
+    DealArenaT arena(1024);
+    benchmark("DealArenaT::dealFast (1024 deals)", 1000, [&]() {
+        arena.dealFast(seed, arena.capacity());
+        seed += arena.capacity();
+        keep(arena.deck(0));
+    });
+}
@@ -0,0 +1,41 @@
+/**
+ * \file benchFortyThievesADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of FortyThievesT dealing, copies, move generation,
+ *   hashing and moves.
+ */
+#include "bench.h"
+#include "FortyThievesADT.h"
+
+
+void benchFortyThievesADT() {
+    uint64_t seed = 0;
+    benchmark("FortyThievesT(seed)", 100000, [&]() {
+        FortyThievesT g(++seed);
+        keep(g);
+    });
+
+    FortyThievesT g(1);
+    const FortyThievesT & cg = g;
+    benchmark("copy FortyThievesT (full board, no history)", 1000000, [&]() {
+        FortyThievesT h = cg;
+        keep(h);
+    });
+
+    MoveBuffer moves;
+    benchmark("FortyThievesT::generateMoves", 1000000, [&]() {
+        cg.generateMoves(moves);
+        keep(moves.size());
+    });
+    benchmark("FortyThievesT::hash", 1000000, [&]() {
+        keep(cg.hash());
+    });
+
+    g.setJournaling(true);
+    MoveT deal(FortyStock, FortyWaste);
+    benchmark("FortyThievesT::performMove + undoMove", 1000000, [&]() {
+        g.performMove(deal);
+        g.undoMove();
+        keep(g.waste().size());
+    });
+}
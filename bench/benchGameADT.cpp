@@ -0,0 +1,129 @@
+/**
+ * \file benchGameADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of the GameT queries, moves, copies and autoplay.
+ */
+#include <exception>
+
+#include "bench.h"
+#include "CardADT.h"
+#include "GameADT.h"
+#include "StackADT.h"
+
+
+// Microsoft deal benchmarked throughout, fixed so that runs compare.
+static const uint64_t BenchSeed = 1;
+
+
+void benchGameADT() {
+    GameT g(BenchSeed);
+    const GameT & cg = g;
+
+    // The validators used to copy a vector-backed Stack per check; these two
+    // show the cost of that copy against the inline column now used.
+    Stack<CardT> vecCol(19);
+    for (CardT c : cg.getCol(Cascade, 0).seq()) {
+        vecCol.push(c);
+    }
+    benchmark("copy Stack<CardT> (vector-backed)", 1000000, [&]() {
+        Stack<CardT> s = vecCol;
+        keep(s);
+    });
+    benchmark("copy ColumnT (inline)", 1000000, [&]() {
+        ColumnT s = cg.getCol(Cascade, 0);
+        keep(s);
+    });
+
+    benchmark("copy GameT (full board, no history)", 1000000, [&]() {
+        GameT h = cg;
+        keep(h);
+    });
+
+    benchmark("GameT::getCol const", 1000000, [&]() {
+        keep(cg.getCol(Cascade, 3).isEmpty());
+    });
+    benchmark("GameT::isValidMove cascade to cascade", 1000000, [&]() {
+        keep(cg.isValidMove(Cascade, 0, Cascade, 1));
+    });
+    benchmark("GameT::isValidMove cascade to foundation", 1000000, [&]() {
+        keep(cg.isValidMove(Cascade, 0, Foundation, 0));
+    });
+    benchmark("GameT::noValidMoves", 100000, [&]() {
+        keep(cg.noValidMoves());
+    });
+
+    // A mix of probes, most of them illegal, as produced by move fuzzing.
+    struct Probe { PlacementT p; unsigned int i; PlacementT q; unsigned int j; };
+    const Probe probes[8] = {
+        { Cascade, 8, Cascade, 0 },
+        { Cell, 0, Foundation, 0 },
+        { Cell, 1, Cascade, 2 },
+        { Cascade, 0, Cascade, 0 },
+        { Cascade, 0, Foundation, 4 },
+        { Foundation, 2, Cell, 0 },
+        { Cascade, 3, Cascade, 3 },
+        { Cascade, 5, Cell, 0 }
+    };
+    benchmark("GameT::isValidMove illegal probes (8, throwing)", 20000, [&]() {
+        unsigned int valid = 0;
+        for (const Probe &pr : probes) {
+            try {
+                valid += cg.isValidMove(pr.p, pr.i, pr.q, pr.j);
+            } catch (std::exception &) {
+            }
+        }
+        keep(valid);
+    });
+    benchmark("GameT::checkMove illegal probes (8)", 20000, [&]() {
+        unsigned int valid = 0;
+        for (const Probe &pr : probes) {
+            valid += cg.checkMove(pr.p, pr.i, pr.q, pr.j) == MoveOk;
+        }
+        keep(valid);
+    });
+
+    MoveBuffer moves;
+    benchmark("GameT::generateMoves", 100000, [&]() {
+        cg.generateMoves(moves);
+        keep(moves.size());
+    });
+    benchmark("GameT::generateMoves with supermoves", 100000, [&]() {
+        cg.generateMoves(moves, true);
+        keep(moves.size());
+    });
+
+    cg.generateMoves(moves);
+    MoveT m = moves[0];
+    g.setJournaling(true);
+    benchmark("GameT::performMove + undoMove (hashed)", 1000000, [&]() {
+        g.performMove(GameT::placement(m.src()), GameT::position(m.src()), GameT::placement(m.dst()), GameT::position(m.dst()));
+        g.undoMove();
+        keep(g.hash());
+    });
+
+    // The same 20 moves, played without and with a journal.
+    GameT played(1);
+    GameT journaled(1);
+    journaled.setJournaling(true);
+    for (unsigned int k = 0; k < 20; k++) {
+        played.generateMoves(moves);
+        if (moves.isEmpty()) {
+            break;
+        }
+        played.applyTrusted(moves[moves.size() - 1]);
+        journaled.applyTrusted(moves[moves.size() - 1]);
+    }
+    benchmark("copy GameT (full board, 20 moves played)", 100000, [&]() {
+        GameT h = played;
+        keep(h);
+    });
+    benchmark("copy GameT (journaling, 20 move history)", 100000, [&]() {
+        GameT h = journaled;
+        keep(h);
+    });
+
+    benchmark("GameT(seed) + autoplay", 100000, [&]() {
+        GameT h(617);
+        keep(h.autoplay());
+    });
+}
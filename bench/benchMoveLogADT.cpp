@@ -0,0 +1,39 @@
+/**
+ * \file benchMoveLogADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of replaying a move log, with and without validation.
+ */
+#include <vector>
+
+#include "bench.h"
+#include "GameADT.h"
+#include "MoveLogADT.h"
+
+
+void benchMoveLogADT() {
+    // A long line of play: alternate a move and its reverse where possible so
+    // the log can be as long as we like.
+    GameT g(617);
+    MoveBuffer moves;
+    std::vector<unsigned char> packed;
+    while (packed.size() < 100000) {
+        g.generateMoves(moves);
+        MoveT m = moves[packed.size() % moves.size()];
+        g.applyTrusted(m);
+        unsigned char b[2];
+        packed.insert(packed.end(), b, b + packMove(m, b));
+    }
+
+    GameT replayed(617);
+    unsigned long applied;
+    benchmark("replayMoves validated (100000 moves)", 20, [&]() {
+        replayed = GameT(617);
+        replayMoves(replayed, packed.data(), packed.size(), true, applied);
+        keep(replayed);
+    });
+    benchmark("replayMoves trusted (100000 moves)", 20, [&]() {
+        replayed = GameT(617);
+        replayMoves(replayed, packed.data(), packed.size(), false, applied);
+        keep(replayed);
+    });
+}
@@ -0,0 +1,42 @@
+/**
+ * \file benchNotationADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of parsing and formatting boards in text notation.
+ */
+#include <sstream>
+#include <string>
+
+#include "bench.h"
+#include "GameADT.h"
+#include "NotationADT.h"
+
+
+void benchNotationADT() {
+    std::string text;
+    formatBoard(GameT(1), text);
+    benchmark("parseBoard", 100000, [&]() {
+        keep(parseBoard(text));
+    });
+
+    GameT g(1);
+    std::string out;
+    benchmark("formatBoard (reused buffer)", 100000, [&]() {
+        out.clear();
+        formatBoard(g, out);
+        keep(out);
+    });
+
+    std::string file;
+    for (uint64_t n = 1; n <= 1000; n++) {
+        formatBoard(GameT(n), file);
+        file += '\n';
+    }
+    benchmark("BoardReaderT (1000 boards)", 100, [&]() {
+        std::istringstream in(file);
+        BoardReaderT reader(in);
+        GameT h(1);
+        while (reader.next(h)) {
+            keep(h);
+        }
+    });
+}
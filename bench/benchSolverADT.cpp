@@ -0,0 +1,20 @@
+/**
+ * \file benchSolverADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of SolverT on a fixed range of deals.
+ */
+#include "bench.h"
+#include "GameADT.h"
+#include "SolverADT.h"
+
+
+void benchSolverADT() {
+    // One solver is reused across deals, as the batch tool does, so its
+    // transposition table is allocated once.
+    SolverT solver;
+    uint64_t seed = 0;
+    benchmark("SolverT::solve (deals 1-10)", 10, [&]() {
+        GameT g(++seed);
+        keep(solver.solve(g).status);
+    });
+}
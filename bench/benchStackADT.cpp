@@ -0,0 +1,59 @@
+/**
+ * \file benchStackADT.cpp
+ * \author agent <agent@local>
+ * \brief Benchmarks of Stack and of the inline ColumnT.
+ */
+#include "bench.h"
+#include "CardADT.h"
+#include "GameADT.h"
+#include "StackADT.h"
+
+
+void benchStackADT() {
+    Stack<int> ints(64);
+    benchmark("Stack<int>::push + pop (vector-backed)", 1000000, [&]() {
+        ints.push(7);
+        ints.pop();
+        keep(ints.size());
+    });
+
+    Stack<CardT> vecCol(19);
+    ColumnT col(19);
+    for (int r = King; r >= Ace; r--) {
+        vecCol.push(CardT(r % 2 ? Spades : Hearts, static_cast<RankT>(r)));
+        col.push(CardT(r % 2 ? Spades : Hearts, static_cast<RankT>(r)));
+    }
+
+    benchmark("Stack<CardT>::peek (vector-backed)", 1000000, [&]() {
+        keep(vecCol.peek().code());
+    });
+    benchmark("ColumnT::peek (inline)", 1000000, [&]() {
+        keep(col.peek().code());
+    });
+    benchmark("Stack<CardT>::pop + push (vector-backed)", 1000000, [&]() {
+        CardT c = vecCol.peek();
+        vecCol.pop();
+        vecCol.push(c);
+        keep(vecCol.size());
+    });
+    benchmark("ColumnT::pop + push (inline)", 1000000, [&]() {
+        CardT c = col.peek();
+        col.pop();
+        col.push(c);
+        keep(col.size());
+    });
+
+    benchmark("Stack<CardT>::seq (13 cards)", 1000000, [&]() {
+        keep(vecCol.seq().size());
+    });
+    benchmark("ColumnT::seq (13 cards)", 1000000, [&]() {
+        keep(col.seq().size());
+    });
+    benchmark("ColumnT::begin/end walk (13 cards)", 1000000, [&]() {
+        unsigned int sum = 0;
+        for (CardT c : col) {
+            sum += c.code();
+        }
+        keep(sum);
+    });
+}
@@ -0,0 +1,70 @@
+// Entry point for the benchmarks. Replaces the global operator new so every
+// benchmark can report the heap allocations it performs.
+//
+// Usage: bench [FILTER...]
+// Only benchmarks whose name contains one of the filters are run.
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "bench.h"
+
+
+static unsigned long long g_allocations = 0;
+static char ** g_filters = 0;
+static int g_filterCount = 0;
+
+
+void * operator new(std::size_t size) {
+    g_allocations++;
+    void * p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+
+unsigned long long allocationCount() {
+    return g_allocations;
+}
+
+
+bool benchSelected(const char * name) {
+    if (g_filterCount == 0) {
+        return true;
+    }
+    for (int k = 0; k < g_filterCount; k++) {
+        if (std::strstr(name, g_filters[k])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+int main(int argc, char ** argv) {
+    g_filters = argv + 1;
+    g_filterCount = argc - 1;
+
+    benchStackADT();
+    benchCardADT();
+    benchGameADT();
+    benchDealADT();
+    benchMoveLogADT();
+    benchNotationADT();
+    benchSolverADT();
+    benchFortyThievesADT();
+    benchBatchGameADT();
+}
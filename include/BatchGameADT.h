@@ -0,0 +1,171 @@
+/**
+ * \file BatchGameADT.h
+ * \author agent <agent@local>
+ * \brief Provides an ADT holding many boards of FreeCell or one of its
+ *   variants in a structure-of-arrays layout, to be queried and stepped in
+ *   lockstep.
+ */
+#ifndef BATCH_GAME_ADT_H
+#define BATCH_GAME_ADT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CardADT.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "MoveADT.h"
+
+
+/**
+ * \brief Represents the states of many independent games of the variant
+ *   `V`, such as the boards of a Monte Carlo rollout.
+ * \details Each board is identified by its index in [0, size()). Rather
+ *   than an array of boards, the batch keeps one array per board column and
+ *   depth: the card at depth `k` of column `x` of every board is contiguous,
+ *   as are the sizes and the top cards of column `x`. The top card of an
+ *   empty column is 0, which is not the code of any card.
+ *
+ *   The queries over every board are single loops over those arrays with no
+ *   branches on the board, so the compiler vectorizes them: a query costs a
+ *   few instructions per board rather than a call per board. Making moves
+ *   touches different columns on each board and is done board by board.
+ *
+ *   The batch holds only the cards and the foundation heights of each
+ *   board: there is no journal, and no hashes or masks are maintained. A
+ *   board is moved in and out of the batch as a BasicGameT with load and
+ *   board.
+ */
+template <class V>
+class BasicBatchGameT {
+    public:
+        typedef BasicGameT<V> GameType;
+
+        static constexpr unsigned int Columns = GameType::Columns;
+
+        /**
+         * \brief Number of cards a column can hold in the batch: the
+         *   capacity of a cascade, which is also enough for a foundation.
+         */
+        static constexpr unsigned int Depth = GameType::CascadeCapacity;
+
+        static_assert(Columns <= 32, "a move mask must fit in 32 bits");
+
+    private:
+        unsigned int m_boards;
+
+        /**
+         * \brief The card at depth `k` of column `x` of board `b`, at
+         *   (x * Depth + k) * m_boards + b. Slots above a column's size are
+         *   unspecified.
+         */
+        std::vector<CardCodeT> m_cards;
+
+        /**
+         * \brief The size and the top card of column `x` of board `b`, at
+         *   x * m_boards + b.
+         */
+        std::vector<unsigned char> m_sizes;
+        std::vector<CardCodeT> m_tops;
+
+        /**
+         * \brief The foundation heights of board `b`, at `b`, maintained by
+         *   applyMoves as GameT maintains its own.
+         */
+        std::vector<FoundationHeightsT> m_heights;
+
+        /**
+         * \brief Throws invalid_placement if `b` is not a board of the batch.
+         */
+        void checkBoard(unsigned int b) const;
+
+    public:
+        /**
+         * \brief Constructs a batch of `boards` boards with every column
+         *   empty, to be filled with load or fill.
+         */
+        explicit BasicBatchGameT(unsigned int boards);
+
+        /**
+         * \brief Returns the number of boards.
+         */
+        unsigned int size() const;
+
+        /**
+         * \brief Replaces board `b` with the board of `g`.
+         * \throws invalid_placement if `b` is not below size().
+         */
+        void load(unsigned int b, const GameType & g);
+
+        /**
+         * \brief Replaces every board with the board of `g`, such as the
+         *   position every rollout of a batch starts from.
+         */
+        void fill(const GameType & g);
+
+        /**
+         * \brief Returns board `b` as a game with an empty history.
+         * \throws invalid_placement if `b` is not below size().
+         */
+        GameType board(unsigned int b) const;
+
+        /**
+         * \brief Gets the top card of board column `x` of board `b`, or 0
+         *   if the column is empty. Board columns are numbered as by
+         *   BasicGameT::column.
+         * \details Not checked: `x` must be below Columns and `b` below
+         *   size().
+         */
+        CardCodeT top(unsigned int b, unsigned int x) const {
+            return m_tops[x * m_boards + b];
+        }
+
+        /**
+         * \brief Determines, for every board, whether the game has been won.
+         * \param won Receives size() entries: entry `b` is 1 if board `b`
+         *   has all 52 cards on its foundations, otherwise 0.
+         */
+        void hasWon(std::vector<unsigned char> & won) const;
+
+        /**
+         * \brief Gets the foundation heights of every board.
+         * \param heights Receives size() entries: entry `b` is the
+         *   foundation heights of board `b`, as BasicGameT::foundationHeights
+         *   would return them.
+         */
+        void foundationHeights(std::vector<FoundationHeightsT> & heights) const;
+
+        /**
+         * \brief Counts the cards on the foundations of every board.
+         * \param counts Receives size() entries: entry `b` is the number of
+         *   cards on the foundations of board `b`, in [0,52].
+         */
+        void homeCounts(std::vector<unsigned char> & counts) const;
+
+        /**
+         * \brief Determines, for every board, which single card moves are
+         *   valid.
+         * \param masks Receives Columns * size() entries. Bit `d` of entry
+         *   s * size() + b is set exactly when moving the top card of board
+         *   column `s` of board `b` on to board column `d` is a valid move,
+         *   i.e. when BasicGameT::checkMove(MoveT(s, d)) would return
+         *   MoveOk. Supermoves are not included.
+         */
+        void moveMasks(std::vector<uint32_t> & masks) const;
+
+        /**
+         * \brief Makes one move on every board without validating them.
+         * \details Entry `b` of `moves` is made on board `b`, and must be a
+         *   valid move on it, such as one taken from moveMasks or a
+         *   supermove from BasicGameT::generateMoves. A move with a count of
+         *   0, such as MoveT(0, 0, 0), leaves its board unchanged, so boards
+         *   whose games are over can sit out.
+         * \throws invalid_move if `moves` does not have size() entries.
+         */
+        void applyMoves(const std::vector<MoveT> & moves);
+};
+
+
+typedef BasicBatchGameT<FreeCell> BatchGameT;
+
+#endif
@@ -7,18 +7,95 @@
 #ifndef CARD_ADT_H
 #define CARD_ADT_H
 
+#include <cstdint>
+
 #include "GameTypes.h"
 
 
+/**
+ * \brief Packed representation of a playing card in a single byte.
+ * \details Bits [0,3] hold the rank and bits [4,5] hold the suit. The red
+ *   suits are enumerated after the black suits in SuitT, so bit 5 alone
+ *   determines the colour of the card. Two cards of the same suit with
+ *   consecutive ranks have consecutive codes.
+ */
+typedef unsigned char CardCodeT;
+
+
+/**
+ * \brief Mask selecting the rank bits of a CardCodeT.
+ */
+#define CARD_RANK_MASK  0x0F
+
+/**
+ * \brief Mask selecting the colour bit of a CardCodeT. Set for red cards.
+ */
+#define CARD_RED_BIT    0x20
+
+
+/**
+ * \brief A set of cards: the bit at the position of a card's CardCodeT is
+ *   set for each card in the set.
+ * \details Codes are below 64, so all 52 cards fit in one word and a
+ *   card's bit needs no arithmetic beyond a shift.
+ */
+typedef uint64_t CardMaskT;
+
+
+/**
+ * \brief Packs a suit and a rank into a CardCodeT.
+ */
+inline CardCodeT packCard(SuitT s, RankT r) {
+    return static_cast<CardCodeT>((s << 4) | (r & CARD_RANK_MASK));
+}
+
+/**
+ * \brief Extracts the suit from a CardCodeT.
+ */
+inline SuitT codeSuit(CardCodeT c) {
+    return static_cast<SuitT>(c >> 4);
+}
+
+/**
+ * \brief Extracts the rank from a CardCodeT.
+ */
+inline RankT codeRank(CardCodeT c) {
+    return c & CARD_RANK_MASK;
+}
+
+/**
+ * \brief Determines whether a CardCodeT is a red card.
+ */
+inline bool codeIsRed(CardCodeT c) {
+    return (c & CARD_RED_BIT) != 0;
+}
+
+/**
+ * \brief Gets the CardMaskT holding only the given card.
+ */
+inline CardMaskT cardBit(CardCodeT c) {
+    return static_cast<CardMaskT>(1) << c;
+}
+
+
 /**
  * \brief ADT for a standard playing card.
+ * \details A thin facade over a CardCodeT; a CardT occupies a single byte.
  */
 class CardT {
     private:
-        SuitT m_s;
-        RankT m_r;
+        CardCodeT m_c;
 
     public:
+        /**
+         * \brief Default constructor for CardT, used to fill unused slots of
+         *   inline storage.
+         *
+         * \details This is a language-specific implementation detail and is
+         * deliberately not in the specification. It should not be used.
+         */
+        CardT();
+
         /**
          * \brief Constructs a new CardT instance.
          * \param S The suit of the card.
@@ -26,6 +103,12 @@ class CardT {
          */
         CardT(SuitT S, RankT R);
 
+        /**
+         * \brief Constructs a new CardT instance from its packed code.
+         * \param c The packed code of the card, as returned by code().
+         */
+        explicit CardT(CardCodeT c);
+
         /**
          * \brief Gets the suit of the card.
          */
@@ -41,6 +124,11 @@ class CardT {
          * \return True if the card is a red suit.
          */
         bool isRed() const;
+
+        /**
+         * \brief Gets the packed code of the card.
+         */
+        CardCodeT code() const { return m_c; }
 };
 
 #endif
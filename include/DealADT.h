@@ -0,0 +1,111 @@
+/**
+ * \file DealADT.h
+ * \author agent <agent@local>
+ * \brief Provides reproducible shuffles of the deck for dealing games of
+ *   FreeCell from a seed.
+ */
+#ifndef DEAL_ADT_H
+#define DEAL_ADT_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "CardADT.h"
+
+
+/**
+ * \brief The 52 cards of a deal in dealing order. The `k`th card is dealt to
+ *   cascade `k % 8`, so the first 8 cards form the bottom row. Other
+ *   variants of BasicGameT deal across their own cascades.
+ */
+typedef std::array<CardCodeT, 52> DeckT;
+
+/**
+ * \brief The 104 cards of two decks in dealing order, as used by Forty
+ *   Thieves. See FortyThievesT for how they are dealt.
+ */
+typedef std::array<CardCodeT, 104> DoubleDeckT;
+
+
+/**
+ * \brief Shuffles the deck exactly as the classic Microsoft FreeCell does for
+ *   a given deal number.
+ * \param n The deal number. Deals 1 to 32000 are the classic set; every
+ *   number up to 2^31 - 1 reproduces the same deal as Microsoft's.
+ */
+DeckT microsoftDeck(uint32_t n);
+
+/**
+ * \brief Shuffles the deck with a fast 64-bit generator.
+ * \details A Fisher-Yates shuffle driven by splitmix64. Every seed gives a
+ *   different, reproducible deal; deals are not those of microsoftDeck.
+ * \param seed Any 64-bit seed.
+ */
+DeckT fastDeck(uint64_t seed);
+
+/**
+ * \brief Shuffles two decks together with the same generator as fastDeck.
+ * \param seed Any 64-bit seed.
+ */
+DoubleDeckT fastDoubleDeck(uint64_t seed);
+
+
+/**
+ * \brief A fixed-capacity arena of deals stored contiguously.
+ * \details The decks of all deals are packed back to back at 52 bytes each,
+ *   separately from their seeds, so scanning the boards streams through
+ *   memory. Fast deals are shuffled several at a time in lockstep: the
+ *   random number generation for a group of decks runs over a short array of
+ *   lanes which the compiler can vectorize, leaving only the swaps scalar.
+ */
+class DealArenaT {
+    private:
+        std::vector<DeckT> m_decks;
+        std::vector<uint64_t> m_seeds;
+        unsigned long m_size;
+
+    public:
+        /**
+         * \brief Constructs an arena able to hold `capacity` deals. All
+         *   memory is allocated here.
+         */
+        DealArenaT(unsigned long capacity);
+
+        /**
+         * \brief Replaces the contents with the FastDeal deals of the `n`
+         *   consecutive seeds starting at `first`.
+         * \details Slot `k` holds exactly fastDeck(first + k).
+         * \throws full if `n` exceeds the capacity.
+         */
+        void dealFast(uint64_t first, unsigned long n);
+
+        /**
+         * \brief Replaces the contents with the `n` consecutive Microsoft
+         *   deals starting at deal number `first`.
+         * \throws full if `n` exceeds the capacity.
+         */
+        void dealMicrosoft(uint32_t first, unsigned long n);
+
+        /**
+         * \brief Returns the number of deals in the arena.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Returns the maximum number of deals the arena can hold.
+         */
+        unsigned long capacity() const;
+
+        /**
+         * \brief Returns the deck of the `k`th deal.
+         */
+        const DeckT & deck(unsigned long k) const;
+
+        /**
+         * \brief Returns the seed or deal number of the `k`th deal.
+         */
+        uint64_t seed(unsigned long k) const;
+};
+
+#endif
@@ -44,4 +44,28 @@ class empty_source : public std::exception {
    }
 };
 
+class empty_history : public std::exception {
+   const char * what () const throw () {
+      return "empty history";
+   }
+};
+
+class invalid_board : public std::exception {
+   const char * what () const throw () {
+      return "invalid board";
+   }
+};
+
+class io_error : public std::exception {
+   const char * what () const throw () {
+      return "io error";
+   }
+};
+
+class invalid_notation : public std::exception {
+   const char * what () const throw () {
+      return "invalid notation";
+   }
+};
+
 #endif
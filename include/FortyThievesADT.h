@@ -0,0 +1,266 @@
+/**
+ * \file FortyThievesADT.h
+ * \author agent <agent@local>
+ * \brief Provides an ADT representing a model for the game of Forty Thieves
+ *   including board state and its transitions.
+ */
+#ifndef FORTY_THIEVES_ADT_H
+#define FORTY_THIEVES_ADT_H
+
+#include <array>
+#include <cstdint>
+
+#include "CardADT.h"
+#include "DealADT.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "JournalADT.h"
+#include "MoveADT.h"
+#include "StackADT.h"
+
+
+/**
+ * \brief A tableau pile. A pile is dealt 4 cards and can then only grow by a
+ *   run down from its top card, so it never holds more than 4 + 12 cards.
+ */
+typedef Stack<CardT, 16> PileT;
+
+/**
+ * \brief The stock or the waste. Each holds at most the 64 cards left over
+ *   after the deal.
+ */
+typedef Stack<CardT, 64> StockT;
+
+
+/**
+ * \brief The board columns of a Forty Thieves game as used in a MoveT.
+ * \details Columns [0,9] are the tableau piles. A move from FortyStock to
+ *   FortyWaste deals a card. Foundations are addressed by suit: a move to
+ *   column FortyFoundation + s places the card on one of the two foundations
+ *   of suit s.
+ */
+enum FortyColumnT {
+    FortyWaste = 10,
+    FortyStock = 11,
+    FortyFoundation = 12
+};
+
+
+/**
+ * \brief The rules of the Forty Thieves tableau as a variant descriptor, for
+ *   the rules shared with BasicGameT such as canStack: piles are built down
+ *   by suit and any card may go on an empty pile.
+ */
+struct FortyThieves {
+    static constexpr bool SameSuit = true;
+    static constexpr bool KingsOnly = false;
+};
+
+
+/**
+ * \brief Represents the state of a Forty Thieves game.
+ * \details Two decks are dealt 4 cards to each of 10 piles, face up, with the
+ *   other 64 cards forming the stock. Piles are built down by suit one card
+ *   at a time and any card may go on an empty pile. The stock is dealt one
+ *   card at a time on to the waste, whose top card may be played, and is
+ *   not redealt. The game is won when all 8 foundations are built up from
+ *   Ace to King.
+ *
+ *   The game is not a BasicGameT variant, as BasicGameT locates and masks
+ *   cards by their code and each code appears twice here. It shares the rest
+ *   with GameT instead: cards, piles, moves, the move buffer, the journal,
+ *   the stacking rule through the FortyThieves descriptor and the Zobrist
+ *   keys. Every container but the journal is sized at compile time, so
+ *   copying a board which is not journaling never allocates. Foundations
+ *   are stored only as heights, and the two foundations of a suit are kept
+ *   with the taller first so that boards which differ only in which of the
+ *   two holds a card are equal.
+ */
+class FortyThievesT {
+    private:
+        std::array<PileT, 10> m_piles;
+        StockT m_waste;
+        StockT m_stock;
+        std::array<unsigned char, 8> m_foundations;
+
+        /**
+         * \brief The Zobrist hash of each pile's cards by depth, and the
+         *   hash of the whole board, maintained by every change to the board
+         *   as GameT maintains its own.
+         */
+        std::array<uint64_t, 10> m_pileHash;
+        uint64_t m_hash;
+
+        /**
+         * \brief Every move made while journaling. See setJournaling.
+         */
+        JournalT m_journal;
+
+        /**
+         * \brief Returns the top card of board column `s`, which must be a
+         *   pile or the waste and not empty.
+         */
+        CardT top(unsigned int s) const;
+
+        /**
+         * \brief Pushes or pops card `c` at depth `depth` of pile `x`,
+         *   updating the hashes.
+         */
+        void pushPile(unsigned int x, CardT c);
+        void popPile(unsigned int x);
+        void togglePile(unsigned int x, CardCodeT c, unsigned int depth);
+
+        /**
+         * \brief Pushes or pops the top of the waste, updating the hash.
+         */
+        void pushWaste(CardT c);
+        void popWaste();
+
+        /**
+         * \brief Sets foundation `f` to height `h`, updating the hash.
+         */
+        void setFoundation(unsigned int f, unsigned int h);
+
+        /**
+         * \brief Moves the top card of board column `s` on to board column
+         *   `d` without any validation.
+         */
+        void transfer(unsigned int s, unsigned int d);
+
+        /**
+         * \brief Reverses transfer(s, d) of `card`.
+         */
+        void untransfer(unsigned int s, unsigned int d, CardCodeT card);
+
+    public:
+        /**
+         * \brief Constructs a new FortyThievesT instance with a reproducible
+         *   deal.
+         * \param seed Any 64-bit seed, shuffled by fastDoubleDeck.
+         */
+        explicit FortyThievesT(uint64_t seed);
+
+        /**
+         * \brief Constructs a new FortyThievesT instance dealing an already
+         *   shuffled pair of decks.
+         * \details Cards [0,39] are dealt in rows across the piles, so card
+         *   `k` goes to pile `k % 10`. The remaining cards form the stock
+         *   with the last card on top, to be dealt first.
+         */
+        explicit FortyThievesT(const DoubleDeckT & deck);
+
+        /**
+         * \brief Gets the `i`th tableau pile.
+         * \throws invalid_placement if `i` is greater than 9.
+         */
+        const PileT & pile(unsigned int i) const;
+
+        /**
+         * \brief Gets the waste.
+         */
+        const StockT & waste() const;
+
+        /**
+         * \brief Gets the stock.
+         */
+        const StockT & stock() const;
+
+        /**
+         * \brief Gets the height of foundation `f`, in [0,13].
+         * \details Foundations 2s and 2s + 1 hold suit s, the taller first.
+         * \throws invalid_placement if `f` is greater than 7.
+         */
+        unsigned int foundationHeight(unsigned int f) const;
+
+        /**
+         * \brief Returns true if all 104 cards are on the foundations.
+         */
+        bool hasWon() const;
+
+        /**
+         * \brief Returns true if no move is possible, including dealing.
+         */
+        bool noValidMoves() const;
+
+        /**
+         * \brief Classifies a move without making it.
+         * \details Only single cards move, so the count must be 1. A move
+         *   must be from a pile or the waste to a pile or a foundation, or
+         *   from the stock to the waste. Never throws.
+         */
+        MoveStatusT checkMove(MoveT m) const;
+
+        /**
+         * \brief Makes a move if checkMove(m) is MoveOk.
+         * \returns The status of the move. The board is unchanged otherwise.
+         */
+        MoveStatusT tryMove(MoveT m);
+
+        /**
+         * \brief Makes a move.
+         * \throws invalid_placement if a column is not a valid source or
+         *   destination.
+         * \throws empty_source if the source has no card.
+         * \throws invalid_move if the rules forbid the move.
+         */
+        void performMove(MoveT m);
+
+        /**
+         * \brief Makes a move without validating it, journaling it if
+         *   journaling. The move must be one for which checkMove returns
+         *   MoveOk, such as one from generateMoves.
+         */
+        void applyTrusted(MoveT m);
+
+        /**
+         * \brief Fills a caller-owned buffer with every valid move.
+         * \details Moves to the foundations come first. Dealing from the
+         *   stock, when possible, comes last.
+         */
+        void generateMoves(MoveBuffer & moves) const;
+
+        /**
+         * \brief Sets whether moves are journaled, so that they can be
+         *   undone. Off by default, as for GameT; turning journaling off
+         *   clears the history.
+         */
+        void setJournaling(bool on);
+
+        /**
+         * \brief Determines whether moves are journaled. See setJournaling.
+         */
+        bool isJournaling() const;
+
+        /**
+         * \brief Reverses the most recent move not yet undone. Only moves
+         *   made while journaling can be undone.
+         * \throws empty_history if there are no moves to undo.
+         */
+        void undoMove();
+
+        /**
+         * \brief Reapplies the most recently undone move.
+         * \throws empty_history if there are no moves to redo.
+         */
+        void redoMove();
+
+        /**
+         * \brief Returns the number of moves which can be undone.
+         */
+        unsigned int undoCount() const;
+
+        /**
+         * \brief Returns the number of moves which can be redone.
+         */
+        unsigned int redoCount() const;
+
+        /**
+         * \brief Returns a hash of the board state.
+         * \details Maintained as moves are made, so this is constant time.
+         *   Boards which differ only in the order of their piles hash
+         *   differently.
+         */
+        uint64_t hash() const;
+};
+
+#endif
@@ -2,29 +2,353 @@
  * \file GameADT.h
  * \author Emily Horsman <horsmane@mcmaster.ca>
  * \brief Provides an ADT representing a model for the game of FreeCell
- *   including board state and its transitions.
+ *   and its variants including board state and its transitions.
  */
 #ifndef GAME_ADT_H
 #define GAME_ADT_H
 
 #include <array>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 
 #include "CardADT.h"
+#include "DealADT.h"
 #include "GameTypes.h"
+#include "JournalADT.h"
+#include "MoveADT.h"
+#include "SnapshotADT.h"
 #include "StackADT.h"
 
 
 /**
- * \brief Represents the state of a FreeCell game.
- * \details The columns are represented as an array of 16 Stack instances with
+ * \brief The most cards a ColumnT can hold.
+ */
+constexpr int ColumnBound = 19;
+
+/**
+ * \brief A single column of cards on the board.
+ * \details Cascades are the largest columns with a capacity of 19, so every
+ *   column can store its cards inline and copying a board never allocates.
+ */
+typedef Stack<CardT, ColumnBound> ColumnT;
+
+
+/**
+ * \brief The heights of the foundations of a board packed in one word: byte
+ *   `s` holds the number of cards of suit `s` on the foundations, in [0,13].
+ * \details The four heights are read and combined with ordinary integer
+ *   arithmetic on the whole word rather than a loop over the suits.
+ */
+typedef uint32_t FoundationHeightsT;
+
+/**
+ * \brief Extracts the height of suit `s` from packed foundation heights.
+ */
+inline unsigned int heightOf(FoundationHeightsT h, SuitT s) {
+    return (h >> (8 * s)) & 0xFF;
+}
+
+/**
+ * \brief Returns the number of cards on the foundations, in [0,52].
+ * \details The multiplication adds every byte into the top byte, which
+ *   cannot overflow as the total is at most 52.
+ */
+inline unsigned int heightsTotal(FoundationHeightsT h) {
+    return (h * 0x01010101u) >> 24;
+}
+
+/**
+ * \brief Determines whether packed foundation heights are those of a won
+ *   game, with every suit built up to its King.
+ */
+inline bool heightsComplete(FoundationHeightsT h) {
+    return h == 0x0D0D0D0Du;
+}
+
+
+/**
+ * \brief Board geometry and rules of classic FreeCell, the variant played by
+ *   GameT.
+ * \details A variant descriptor gives, as compile-time constants, the number
+ *   of cascades and free cells, how many dealt cards go to the free cells
+ *   rather than the cascades, whether cascades are built down by suit rather
+ *   than by alternating colour, and whether only Kings may fill an empty
+ *   cascade. Every variant has 4 foundations.
+ */
+struct FreeCell {
+    static constexpr unsigned int Cascades = 8;
+    static constexpr unsigned int Cells = 4;
+    static constexpr unsigned int DealtToCells = 0;
+    static constexpr bool SameSuit = false;
+    static constexpr bool KingsOnly = false;
+};
+
+/**
+ * \brief FreeCell built down by suit.
+ */
+struct BakersGame {
+    static constexpr unsigned int Cascades = 8;
+    static constexpr unsigned int Cells = 4;
+    static constexpr unsigned int DealtToCells = 0;
+    static constexpr bool SameSuit = true;
+    static constexpr bool KingsOnly = false;
+};
+
+/**
+ * \brief 8 cascades of 6 cards and 8 cells, 4 of them dealt to; built down
+ *   by suit with only Kings on empty cascades.
+ */
+struct EightOff {
+    static constexpr unsigned int Cascades = 8;
+    static constexpr unsigned int Cells = 8;
+    static constexpr unsigned int DealtToCells = 4;
+    static constexpr bool SameSuit = true;
+    static constexpr bool KingsOnly = true;
+};
+
+/**
+ * \brief Seahaven Towers: 10 cascades of 5 cards and 4 cells, 2 of them
+ *   dealt to; built down by suit with only Kings on empty cascades.
+ */
+struct Seahaven {
+    static constexpr unsigned int Cascades = 10;
+    static constexpr unsigned int Cells = 4;
+    static constexpr unsigned int DealtToCells = 2;
+    static constexpr bool SameSuit = true;
+    static constexpr bool KingsOnly = true;
+};
+
+/**
+ * \brief FreeCell with only 2 free cells.
+ */
+struct TwoCellFreeCell {
+    static constexpr unsigned int Cascades = 8;
+    static constexpr unsigned int Cells = 2;
+    static constexpr unsigned int DealtToCells = 0;
+    static constexpr bool SameSuit = false;
+    static constexpr bool KingsOnly = false;
+};
+
+
+/**
+ * \brief Determines whether card `c` may be built on a foundation whose top
+ *   card is `dstTop`, or which is empty if `dstEmpty`: a foundation is built
+ *   up by suit from the Ace.
+ */
+inline bool canBuild(CardCodeT c, bool dstEmpty, CardCodeT dstTop) {
+    if (dstEmpty) {
+        return codeRank(c) == Ace;
+    }
+
+    // Same suit and one rank lower is exactly the preceding code.
+    return dstTop + 1 == c;
+}
+
+/**
+ * \brief Determines whether card `c` may be stacked on a cascade whose top
+ *   card is `dstTop`, or which is empty if `dstEmpty`, under the rules of
+ *   the descriptor `V`.
+ * \details Only `V::SameSuit` and `V::KingsOnly` are read, so games other
+ *   than BasicGameT, such as FortyThievesT, share the rule through a
+ *   descriptor of their own. The rules are compile-time constants, so each
+ *   instantiation keeps only its own.
+ */
+template <class V>
+inline bool canStack(CardCodeT c, bool dstEmpty, CardCodeT dstTop) {
+    if (dstEmpty) {
+        return !V::KingsOnly || codeRank(c) == King;
+    }
+
+    if (V::SameSuit) {
+        return dstTop == c + 1;
+    }
+
+    return (
+        ((dstTop ^ c) & CARD_RED_BIT) &&
+        (dstTop & CARD_RANK_MASK) == (c & CARD_RANK_MASK) + 1
+    );
+}
+
+
+/**
+ * \brief Represents the state of a game of FreeCell or one of its variants.
+ * \details The columns are represented as an array of Stack instances with
  *   an enumeration from GameTypes and an integer to identify each stack with
  *   a placement on the board (e.g., (Cascade, 0) for the first cascade).
+ *
+ *   The geometry and rules come from the variant descriptor `V`, such as
+ *   FreeCell, as compile-time constants, so each variant compiles to its own
+ *   code with the rules of the others folded away.
  */
-class GameT {
+template <class V>
+class BasicGameT {
+    public:
+        static constexpr unsigned int Cascades = V::Cascades;
+        static constexpr unsigned int Cells = V::Cells;
+        static constexpr unsigned int Foundations = 4;
+
+        /**
+         * \brief Number of board columns: the cascades, then the free cells,
+         *   then the foundations.
+         */
+        static constexpr unsigned int Columns = Cascades + Cells + Foundations;
+
+        /**
+         * \brief Capacity of a cascade: the most cards dealt to one, plus 12
+         *   more stacked down from a King.
+         */
+        static constexpr unsigned int CascadeCapacity =
+            (52 - V::DealtToCells + Cascades - 1) / Cascades + 12;
+
+        /**
+         * \brief A move buffer large enough for generateMoves. See
+         *   MoveBuffer.
+         */
+        typedef BasicMoveBuffer<Columns * (Columns - 1) + Cascades * (Cascades - 1) * 12> MoveBufferT;
+
+        static_assert(Columns <= 32, "board columns must fit in a MoveT");
+        static_assert(CascadeCapacity <= ColumnBound, "cascades must fit in a ColumnT");
+
+        /**
+         * \brief Maps a (PlacementT, unsigned int) pair to its board column.
+         */
+        static unsigned int column(PlacementT p, unsigned int i) {
+            return p == Cascade ? i : (p == Cell ? i + Cascades : i + Cascades + Cells);
+        }
+
+        /**
+         * \brief Gets the placement of a board column.
+         */
+        static PlacementT placement(unsigned int col) {
+            return col < Cascades ? Cascade : (col < Cascades + Cells ? Cell : Foundation);
+        }
+
+        /**
+         * \brief Gets the index of a board column within its placement, so
+         *   that column(placement(col), position(col)) is `col`.
+         */
+        static unsigned int position(unsigned int col) {
+            return col - column(placement(col), 0);
+        }
+
+        /**
+         * \brief Constructs a move between two (PlacementT, unsigned int)
+         *   pairs, as taken by performMove, on this variant's board columns.
+         */
+        static MoveT move(PlacementT p, unsigned int i, PlacementT q, unsigned int j, unsigned int count = 1) {
+            return MoveT(column(p, i), column(q, j), count);
+        }
+
     private:
-        std::array<Stack<CardT>, 16> m_cols;
+        std::array<ColumnT, Columns> m_cols;
+
+        /**
+         * \brief Every move made while journaling. See setJournaling.
+         */
+        JournalT m_journal;
+
+        /**
+         * \brief Whether autoplay runs after every move. See setAutoplay.
+         */
+        bool m_autoplay;
+
+        /**
+         * \brief Zobrist hash of each column on its own: the exclusive-or
+         *   of zobristKey(card, depth) over its cards.
+         * \details This and the hashes, masks and m_where below are derived
+         *   from the columns, and mutable so that a const query can bring
+         *   them up to date after the deprecated mutable getCol. See sync.
+         */
+        mutable std::array<uint64_t, Columns> m_colHash;
+
+        /**
+         * \brief Combinations of m_colHash maintained by transfer. See
+         *   hash() and canonicalHash().
+         */
+        mutable uint64_t m_hash;
+        mutable uint64_t m_canonicalHash;
+
+        /**
+         * \brief Card masks maintained by transfer: the top cards of the
+         *   cascades, the cards in the free cells, and the card each suit
+         *   needs next on the foundations.
+         */
+        mutable CardMaskT m_tops;
+        mutable CardMaskT m_cells;
+        mutable CardMaskT m_next;
+
+        /**
+         * \brief The height of each suit's foundation, maintained by
+         *   transfer alongside m_next.
+         */
+        mutable FoundationHeightsT m_heights;
+
+        /**
+         * \brief The board column holding each card, indexed by its code.
+         *   Columns for cards not on the board.
+         */
+        mutable std::array<unsigned char, 64> m_where;
+
+        /**
+         * \brief Whether a column may have changed through the mutable
+         *   getCol since the hashes and masks were last computed.
+         */
+        mutable bool m_stale;
+
+        /**
+         * \brief Recomputes every hash from the columns.
+         */
+        void rehash() const;
+
+        /**
+         * \brief Recomputes the card masks and m_where from the columns.
+         */
+        void remask() const;
+
+        /**
+         * \brief Recomputes the hashes and masks if the mutable getCol may
+         *   have changed a column. Called first by everything which reads
+         *   them, so it costs one well-predicted branch unless that getCol
+         *   was used.
+         */
+        void sync() const {
+            if (m_stale) {
+                resync();
+            }
+        }
+        void resync() const;
+
+        /**
+         * \brief Removes the top card of board column `x` from the card
+         *   masks, before the column changes.
+         */
+        void unmarkColumn(unsigned int x);
+
+        /**
+         * \brief Adds the top card of board column `x` to the card masks,
+         *   after the column has changed.
+         */
+        void markColumn(unsigned int x) const;
+
+        /**
+         * \brief Sets up empty columns and deals the given deck on to the
+         *   cascades.
+         * \details Card `k` goes to cascade `k % Cascades`, except that the
+         *   last V::DealtToCells cards go to the first free cells.
+         */
+        void deal(const DeckT & deck);
+
+        /**
+         * \brief Sets up every column empty with its capacity.
+         */
+        void makeColumns();
+
+        /**
+         * \brief Replaces the hash of board column `x` and updates the
+         *   board hashes to match.
+         */
+        void setColumnHash(unsigned int x, uint64_t h);
 
         /**
          * \brief Determines whether a given (PlacementT, unsigned int) pair is
@@ -36,44 +360,130 @@ class GameT {
          * \brief Determines whether the given card can be placed on the
          *   `j`th foundation.
          */
-        bool isValidBuild(CardT c, unsigned int j);
+        bool isValidBuild(CardT c, unsigned int j) const;
 
         /**
          * \brief Determines whether the given card can be stacked on the
          *   `j`th cascade.
          */
-        bool isValidStack(CardT c, unsigned int j);
+        bool isValidStack(CardT c, unsigned int j) const;
+
+        /**
+         * \brief Determines whether the top card of board column `s` can be
+         *   moved on to board column `d`.
+         * \details Board columns are numbered as by column(). Column `s`
+         *   must not be empty. Never throws.
+         */
+        bool isLegal(unsigned int s, unsigned int d) const;
+
+        /**
+         * \brief Determines whether the top `n` cards of cascade `s` can be
+         *   moved together on to cascade `d` as a supermove.
+         * \details `n` must be at least 2. Never throws.
+         */
+        bool isLegalRun(unsigned int s, unsigned int d, unsigned int n) const;
 
         /**
-         * \brief Implementation-specific function for getting a vector of all
-         *   possible board positions.
+         * \brief Moves the top `n` cards of board column `s` on to board
+         *   column `d` without any validation, recording it in the journal.
          */
-        std::vector<std::tuple<PlacementT, unsigned int>> getAllPositions() const;
+        void applyMove(unsigned int s, unsigned int d, unsigned int n = 1);
+
+        /**
+         * \brief Appends the move of the top `n` cards of board column `s`
+         *   on to board column `d` to the journal, before it is made.
+         */
+        void record(unsigned int s, unsigned int d, unsigned int n, bool automatic);
+
+        /**
+         * \brief Moves the top `n` cards of board column `s` on to board
+         *   column `d`, keeping their order. The primitive through which all
+         *   card movement happens.
+         */
+        void transfer(unsigned int s, unsigned int d, unsigned int n = 1);
 
     public:
         /**
          * \brief Constructs a new GameT instance with a randomly shuffled
          *   playing field.
+         * \details Seeds a FastDeal from std::random_device, so no random
+         *   state is shared between threads.
+         */
+        BasicGameT();
+
+        /**
+         * \brief Constructs a new GameT instance with a reproducible deal.
+         * \param seed The deal number or seed. For MicrosoftDeal only the
+         *   low 32 bits are used.
+         * \param mode How the seed is turned into a deal.
          */
-        GameT();
+        explicit BasicGameT(uint64_t seed, DealT mode = MicrosoftDeal);
+
+        /**
+         * \brief Constructs a new GameT instance dealing an already shuffled
+         *   deck, such as one from a DealArenaT.
+         * \param deck The cards in dealing order.
+         */
+        explicit BasicGameT(const DeckT & deck);
+
+        /**
+         * \brief Constructs a new GameT instance from a snapshot, such as one
+         *   read from a SnapshotFileT.
+         * \throws invalid_board if the snapshot does not hold 52 cards or a
+         *   column holds more cards than its capacity.
+         */
+        explicit BasicGameT(const SnapshotViewT & s);
 
         /**
          * \brief Constructs a new GameT instance with a given board state.
-         * \param cols All columns on the board.
-         *   Columns [0,7] are the cascades.
-         *   Columns [8,11] are the free cells.
-         *   Columns [12,15] are the foundations.
+         * \param cols All columns on the board, numbered as by column().
+         *   For GameT, columns [0,7] are the cascades, columns [8,11] are
+         *   the free cells and columns [12,15] are the foundations.
+         *   Each column keeps the capacity of its stack, limited to the
+         *   ColumnBound cards a ColumnT holds; a default-constructed stack
+         *   stays a column which cannot take any card.
          * \throws invalid_board if the board does not contain all 52 distinct
-         *   playing cards in valid stacks.
+         *   playing cards in valid stacks, or a column holds more than
+         *   ColumnBound cards.
          */
-        GameT(std::array<Stack<CardT>, 16> cols);
+        BasicGameT(std::array<Stack<CardT>, Columns> cols);
+
+        /**
+         * \brief Constructs a new GameT instance with a given board state
+         *   already held in inline columns.
+         * \param cols All columns on the board, laid out as above.
+         */
+        BasicGameT(const std::array<ColumnT, Columns> & cols);
+
+        /**
+         * \brief Copies a game, with its journal if it is journaling.
+         * \details Written out rather than left to the compiler only so
+         *   that copies are counted by StatsADT.
+         */
+        BasicGameT(const BasicGameT & g);
+        BasicGameT & operator=(const BasicGameT & g);
+
+        BasicGameT(BasicGameT && g) = default;
+        BasicGameT & operator=(BasicGameT && g) = default;
 
         /**
          * \brief Determines whether the game has concluded with a victory.
+         * \details A single comparison of foundationHeights().
          * \return True if the state is won.
          */
         bool hasWon() const;
 
+        /**
+         * \brief Gets the height of each suit's foundation, packed as
+         *   FoundationHeightsT. Maintained by every move.
+         */
+        FoundationHeightsT foundationHeights() const;
+
+        /**
+         * \brief Returns the number of cards on the foundations, in [0,52].
+         */
+        unsigned int homeCount() const;
+
         /**
          * \brief Determine whether the given move is a valid move in the
          *   current playing state.
@@ -88,19 +498,51 @@ class GameT {
          * \param j Destination column index. 0-indexed.
          * \throws invalid_placement if either the source or destination
          *   placement are not valid playing positions. Cell indices must be
-         *   in [0,3]. Foundation indices must be in [0,3]. Cascade indices
-         *   must be in [0,7].
+         *   below Cells. Foundation indices must be in [0,3]. Cascade
+         *   indices must be below Cascades.
          * \throws empty_source if the source position has no card to move.
          * \return True if this move can be made.
          */
-        bool isValidMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j);
+        bool isValidMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) const;
 
         /**
          * \brief Determine whether there are any remaining valid moves which
          *   could be played in the current state.
          * \return True if there are no valid moves.
          */
-        bool noValidMoves();
+        bool noValidMoves() const;
+
+        /**
+         * \brief Writes every valid move in the current playing state into
+         *   a caller-owned buffer, replacing its contents.
+         * \details A single card move is valid exactly when isValidMove
+         *   would return true for it. The single card moves come first,
+         *   ordered by source then destination column, and are found from
+         *   the card masks rather than by trying every pair of columns.
+         *   Never throws and never allocates.
+         * \param moves Buffer receiving the moves.
+         * \param supermoves If true, also writes every valid supermove, so
+         *   a run of cards can be moved in one ply.
+         */
+        void generateMoves(MoveBufferT & moves, bool supermoves = false) const;
+
+        /**
+         * \brief Returns the number of cards at the top of cascade `i` which
+         *   form a run: each card one rank lower than, and of the opposite
+         *   colour to, the card below it. 0 if the cascade is empty.
+         * \throws invalid_placement if `i` is not a cascade.
+         */
+        unsigned int runLength(unsigned int i) const;
+
+        /**
+         * \brief Returns the largest number of cards which can be moved
+         *   together between cascades: (free cells + 1) * 2^(empty
+         *   cascades), or just (free cells + 1) when only Kings may fill an
+         *   empty cascade.
+         * \param toEmptyCascade True if the destination is an empty cascade,
+         *   which then cannot be counted among the empty cascades.
+         */
+        unsigned int supermoveCapacity(bool toEmptyCascade) const;
 
         /**
          * \brief Updates the playing state given a valid source position and
@@ -111,20 +553,252 @@ class GameT {
          * \param j Destination column index. 0-indexed.
          * \throws invalid_placement if either the source or destination
          *   placement are not valid playing positions. Cell indices must be
-         *   in [0,3]. Foundation indices must be in [0,3]. Cascade indices
-         *   must be in [0,7].
+         *   below Cells. Foundation indices must be in [0,3]. Cascade
+         *   indices must be below Cascades.
          * \throws empty_source if the source position has no card to move.
          */
         void performMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j);
 
         /**
-         * \brief Retrieves the Stack instance given an associated board
-         *   column. Required for the View to render game state.
+         * \brief Updates the playing state given a move, which may be a
+         *   supermove.
+         * \details A supermove moves the top `m.count()` cards of a cascade
+         *   on to another cascade in one operation. They must form a run no
+         *   longer than supermoveCapacity allows, and the bottom card of the
+         *   run must be a valid stack on the destination.
+         * \throws empty_source if the source column has no card to move.
+         * \throws invalid_move if the move cannot be made.
+         */
+        void performMove(MoveT m);
+
+        /**
+         * \brief Exception-free counterpart of isValidMove.
+         * \param p Source placement.
+         * \param i Source column index. 0-indexed.
+         * \param q Destination placement.
+         * \param j Destination column index. 0-indexed.
+         * \return MoveOk if the move can be made, otherwise the status
+         *   corresponding to the exception isValidMove or performMove would
+         *   throw.
+         */
+        MoveStatusT checkMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) const;
+
+        /**
+         * \brief Exception-free counterpart of performMove taking a MoveT.
+         * \return MoveOk if the move can be made, otherwise the status
+         *   corresponding to the exception performMove would throw.
+         */
+        MoveStatusT checkMove(MoveT m) const;
+
+        /**
+         * \brief Exception-free counterpart of performMove. Updates the
+         *   playing state only if the move is valid.
+         * \param p Source placement.
+         * \param i Source column index. 0-indexed.
+         * \param q Destination placement.
+         * \param j Destination column index. 0-indexed.
+         * \return The status from checkMove; the move was made if it is
+         *   MoveOk.
+         */
+        MoveStatusT tryMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j);
+
+        /**
+         * \brief Exception-free counterpart of performMove taking a MoveT,
+         *   as produced by generateMoves.
+         * \return The status from checkMove; the move was made if it is
+         *   MoveOk.
+         */
+        MoveStatusT tryMove(MoveT m);
+
+        /**
+         * \brief Makes a move without validating it, for replaying moves
+         *   already known to be valid such as those of a trusted log.
+         * \details The move is journaled like any other. The move must be
+         *   valid in the current state; the behaviour is undefined otherwise.
+         */
+        void applyTrusted(MoveT m);
+
+        /**
+         * \brief Moves every card which is provably safe to the foundations.
+         * \details A card is safe once no card left in play could need to be
+         *   stacked on it: it is an Ace or a 2, or both foundations of the
+         *   opposite colour have been built up to at least one rank below
+         *   it. When building by suit every card which can go to the
+         *   foundations is safe. Repeats until no safe card is left.
+         *
+         *   While journaling, the cards moved are journaled as part of the
+         *   most recent move, so undoMove reverses them together with it and
+         *   the history stays usable; with no earlier move they form a move
+         *   of their own. A game which is not journaling skips the journal.
+         * \return The number of cards moved.
+         */
+        unsigned int autoplay();
+
+        /**
+         * \brief Sets whether autoplay runs after every move made
+         *   through performMove, tryMove or applyTrusted. Off by default.
+         */
+        void setAutoplay(bool on);
+
+        /**
+         * \brief Sets whether moves are journaled, so that they can be
+         *   undone. Off by default.
+         * \details The journal is the only part of a game held outside the
+         *   object, so a game which does not journal is copied without
+         *   allocating; one which does copies its history with it. Turning
+         *   journaling off clears the history.
+         */
+        void setJournaling(bool on);
+
+        /**
+         * \brief Determines whether moves are journaled. See setJournaling.
+         */
+        bool isJournaling() const;
+
+        /**
+         * \brief Reverses the most recent move which has not been undone.
+         *   Only moves made while journaling can be undone.
+         * \details Runs in constant time; the undone move can be reapplied
+         *   with redoMove until another move is made. Cards moved by
+         *   journaled autoplay after the move are undone with it.
+         * \throws empty_history if there is no move to undo.
+         */
+        void undoMove();
+
+        /**
+         * \brief Reapplies the most recently undone move.
+         * \throws empty_history if there is no undone move to redo.
+         */
+        void redoMove();
+
+        /**
+         * \brief Undoes the last `n` moves.
+         * \throws empty_history if fewer than `n` moves can be undone. The
+         *   state is unchanged in that case.
+         */
+        void rewind(unsigned int n);
+
+        /**
+         * \brief Returns the number of moves which can currently be undone.
+         */
+        unsigned int undoCount() const;
+
+        /**
+         * \brief Returns the number of moves which can currently be redone.
+         */
+        unsigned int redoCount() const;
+
+        /**
+         * \brief Writes the moves which can currently be undone into `out`,
+         *   oldest first, replacing its contents. Cards moved by journaled
+         *   autoplay appear as moves of their own.
+         */
+        void history(std::vector<MoveT> & out) const;
+
+        /**
+         * \brief Forgets every recorded move, keeping the current state.
+         */
+        void clearHistory();
+
+        /**
+         * \brief Encodes the board state as a fixed-size snapshot.
+         * \throws invalid_board if the board does not hold 52 cards, or the
+         *   variant has more than the 16 columns a snapshot holds.
+         */
+        SnapshotT snapshot() const;
+
+        /**
+         * \brief Gets a 64-bit Zobrist hash of the board state.
+         * \details Maintained incrementally by every move, undo and redo, so
+         *   this is a constant time query. Equal boards have equal hashes.
+         */
+        uint64_t hash() const;
+
+        /**
+         * \brief Gets a 64-bit Zobrist hash which ignores the order of the
+         *   cascades, of the free cells and of the foundations.
+         * \details Boards which only differ by a permutation of those columns
+         *   play identically and have the same canonical hash. Also
+         *   maintained incrementally.
+         */
+        uint64_t canonicalHash() const;
+
+        /**
+         * \brief Gets the set of cards on top of the cascades.
+         * \details Maintained by every move, as are cellMask and
+         *   foundationMask, so that move queries are a few mask operations.
+         *   For example a card can go to the foundations exactly if it is in
+         *   `(topMask() | cellMask()) & foundationMask()`.
+         */
+        CardMaskT topMask() const;
+
+        /**
+         * \brief Gets the set of cards in the free cells.
+         */
+        CardMaskT cellMask() const;
+
+        /**
+         * \brief Gets the set of cards which can go to the foundations next:
+         *   for each suit, the card one rank above its foundation, or its
+         *   Ace if it has none.
+         */
+        CardMaskT foundationMask() const;
+
+        /**
+         * \brief Gets the set of cards on top of the cascades on which `c`
+         *   could be stacked. Pass a card from the result to columnOf to find
+         *   its cascade.
+         */
+        CardMaskT stackTargets(CardT c) const;
+
+        /**
+         * \brief Gets the board column holding a card, numbered as by
+         *   column(), in constant time.
+         * \return Columns if the card is not on the board.
+         */
+        unsigned int columnOf(CardT c) const;
+
+        /**
+         * \brief Retrieves a read-only reference to the Stack instance at the
+         *   given board column without copying it. Required for the View to
+         *   render game state.
+         * \details Columns can only be changed through moves, which keeps
+         *   the hashes consistent with the board.
          * \throws invalid_placement if the given placement is not a valid
          *   column.
          * \return Stack instance at given column.
          */
-        Stack<CardT> & getCol(PlacementT p, unsigned int i);
+        const ColumnT & getCol(PlacementT p, unsigned int i) const;
+
+        /**
+         * \brief Retrieves a mutable reference to the Stack instance at the
+         *   given board column.
+         * \deprecated Kept for callers which edit the board directly. A
+         *   change through the reference is not a move and is not
+         *   journaled, so moves made before it may no longer undo. After
+         *   each call the hashes and masks are recomputed from every column
+         *   when next read. Make moves, or construct a board from its
+         *   columns, instead, and read columns through a const reference to
+         *   avoid the recomputation.
+         * \throws invalid_placement if the given placement is not a valid
+         *   column.
+         */
+        __attribute__((deprecated("edit the board through moves or construct it from columns")))
+        ColumnT & getCol(PlacementT p, unsigned int i);
 };
 
+
+template <class V> constexpr unsigned int BasicGameT<V>::Cascades;
+template <class V> constexpr unsigned int BasicGameT<V>::Cells;
+template <class V> constexpr unsigned int BasicGameT<V>::Foundations;
+template <class V> constexpr unsigned int BasicGameT<V>::Columns;
+template <class V> constexpr unsigned int BasicGameT<V>::CascadeCapacity;
+
+
+typedef BasicGameT<FreeCell> GameT;
+typedef BasicGameT<BakersGame> BakersGameT;
+typedef BasicGameT<EightOff> EightOffT;
+typedef BasicGameT<Seahaven> SeahavenT;
+typedef BasicGameT<TwoCellFreeCell> TwoCellGameT;
+
 #endif
@@ -17,8 +17,31 @@ enum PlacementT {
 };
 
 
+/**
+ * \brief Describes how a deal number or seed is turned into a deal.
+ */
+enum DealT {
+    MicrosoftDeal,  ///< The numbering of the classic Microsoft FreeCell.
+    FastDeal        ///< A fast 64-bit generator for bulk dealing.
+};
+
+
+/**
+ * \brief Describes the outcome of checking or attempting a move without
+ *   exceptions. Each failure corresponds to an exception from Exceptions.h.
+ */
+enum MoveStatusT {
+    MoveOk,                ///< The move is valid.
+    MoveInvalidPlacement,  ///< A position is off the board; invalid_placement.
+    MoveEmptySource,       ///< The source has no card; empty_source.
+    MoveInvalid            ///< The rules forbid the move; invalid_move.
+};
+
+
 /**
  * \brief Describes the possible card suits.
+ * \details The black suits come first so that the colour of a suit is its
+ *   second bit. CardCodeT relies on this ordering.
  */
 enum SuitT {
     Spades,
@@ -0,0 +1,146 @@
+/**
+ * \file JournalADT.h
+ * \author agent <agent@local>
+ * \brief Provides the undo journal shared by GameT and FortyThievesT.
+ */
+#ifndef JOURNAL_ADT_H
+#define JOURNAL_ADT_H
+
+#include <vector>
+
+#include "CardADT.h"
+#include "MoveADT.h"
+
+
+/**
+ * \brief A record of a single move applied to a game, enough to reverse or
+ *   reapply it.
+ */
+struct JournalEntryT {
+    unsigned char src;    ///< Source board column.
+    unsigned char dst;    ///< Destination board column.
+    CardCodeT card;       ///< The card which was moved, or the bottom card of the run.
+    unsigned char count;  ///< Number of cards moved.
+    bool automatic;       ///< True if made by autoplay, as part of the move before it.
+};
+
+
+/**
+ * \brief The moves made in a game, oldest first, with a cursor separating
+ *   the moves which can be undone from those which can be redone.
+ * \details The journal only keeps the entries; the game reverses and
+ *   reapplies them. An automatic entry belongs to the move before it, so a
+ *   move is undone and redone together with the automatic entries after it.
+ *
+ *   A journal records nothing until enabled, so a game which does not
+ *   journal holds an empty vector and copying it never allocates.
+ */
+class JournalT {
+    private:
+        /**
+         * \brief Every entry recorded, oldest first. Entries from m_applied
+         *   onwards have been undone and may be redone.
+         */
+        std::vector<JournalEntryT> m_entries;
+        unsigned int m_applied;
+
+        /**
+         * \brief Number of moves, counting each move together with the
+         *   automatic entries after it as one, before m_applied and in the
+         *   whole journal.
+         */
+        unsigned int m_undoable;
+        unsigned int m_recorded;
+
+        bool m_enabled;
+
+        /**
+         * \brief Determines whether entry `k` begins a move: it is not
+         *   automatic, or it is the first entry.
+         */
+        bool beginsMove(unsigned int k) const;
+
+    public:
+        /**
+         * \brief Constructs an empty journal, not enabled.
+         */
+        JournalT();
+
+        /**
+         * \brief Copies a journal. The copy of the entries is charged to the
+         *   outermost instrumented call, as by statAssign.
+         */
+        JournalT(const JournalT & j);
+        JournalT & operator=(const JournalT & j);
+
+        JournalT(JournalT && j) = default;
+        JournalT & operator=(JournalT && j) = default;
+
+        /**
+         * \brief Sets whether record keeps entries. Disabling the journal
+         *   clears it.
+         */
+        void setEnabled(bool on);
+
+        /**
+         * \brief Determines whether record keeps entries.
+         */
+        bool isEnabled() const;
+
+        /**
+         * \brief Appends an entry, discarding any undone moves. Does nothing
+         *   unless enabled.
+         */
+        void record(const JournalEntryT & e);
+
+        /**
+         * \brief Moves the cursor back over the most recent move which has
+         *   not been undone.
+         * \return The number of entries of that move, which are then at
+         *   [applied(), applied() + n) and are to be reversed last first.
+         * \throws empty_history if there is no move to undo.
+         */
+        unsigned int undo();
+
+        /**
+         * \brief Moves the cursor forward over the most recently undone
+         *   move.
+         * \return The number of entries of that move, which are then at
+         *   [applied() - n, applied()) and are to be reapplied in order.
+         * \throws empty_history if there is no undone move to redo.
+         */
+        unsigned int redo();
+
+        /**
+         * \brief Gets entry `k`, which must be below the number recorded.
+         */
+        const JournalEntryT & operator[](unsigned int k) const { return m_entries[k]; }
+
+        /**
+         * \brief Returns the number of entries before the cursor.
+         */
+        unsigned int applied() const { return m_applied; }
+
+        /**
+         * \brief Returns the number of moves which can be undone.
+         */
+        unsigned int undoCount() const { return m_undoable; }
+
+        /**
+         * \brief Returns the number of moves which can be redone.
+         */
+        unsigned int redoCount() const { return m_recorded - m_undoable; }
+
+        /**
+         * \brief Writes the entries before the cursor into `out` as moves,
+         *   oldest first, replacing its contents.
+         */
+        void history(std::vector<MoveT> & out) const;
+
+        /**
+         * \brief Forgets every entry, keeping the journal enabled or not.
+         */
+        void clear();
+};
+
+#endif
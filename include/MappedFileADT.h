@@ -0,0 +1,49 @@
+/**
+ * \file MappedFileADT.h
+ * \author agent <agent@local>
+ * \brief Provides a read-only memory mapping of a file which starts with a
+ *   magic number, shared by the binary file readers.
+ */
+#ifndef MAPPED_FILE_ADT_H
+#define MAPPED_FILE_ADT_H
+
+#include <string>
+
+
+/**
+ * \brief A file mapped read-only for the lifetime of the object.
+ */
+class MappedFileT {
+    private:
+        const unsigned char * m_map;
+        unsigned long m_bytes;
+
+        MappedFileT(const MappedFileT &);
+        MappedFileT & operator=(const MappedFileT &);
+
+    public:
+        /**
+         * \brief Maps the file at `path`.
+         * \param magic The `magicBytes` bytes the file must start with.
+         * \param minBytes The smallest size the file may have; the magic
+         *   number is always required to fit.
+         * \throws io_error if the file cannot be mapped, is too short or
+         *   does not start with `magic`. Nothing is left mapped.
+         */
+        MappedFileT(const std::string & path, const char * magic, unsigned long magicBytes,
+                    unsigned long minBytes = 0);
+
+        ~MappedFileT();
+
+        /**
+         * \brief Returns the first byte of the file.
+         */
+        const unsigned char * data() const;
+
+        /**
+         * \brief Returns the size of the file in bytes.
+         */
+        unsigned long size() const;
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * \file MoveADT.h
+ * \author agent <agent@local>
+ * \brief Provides a compact representation of a move between two board
+ *   columns and a fixed-capacity buffer of moves.
+ */
+#ifndef MOVE_ADT_H
+#define MOVE_ADT_H
+
+#include <array>
+#include <cstdint>
+
+#include "Exceptions.h"
+#include "GameTypes.h"
+
+
+/**
+ * \brief A move of the top card, or the top run of cards, of one board column
+ *   on to another.
+ * \details Stored as the two board column indices, 5 bits each, and the
+ *   number of cards moved, 6 bits, packed so that a move fits in two bytes.
+ *   Column indices reach 31 so that every variant of BasicGameT fits. A move
+ *   of more than one card is a supermove; see GameT::supermoveCapacity.
+ *
+ *   A move knows nothing of the board layout: the variant maps placements
+ *   to board columns, with BasicGameT::column, placement and position, and
+ *   builds a move from placements with BasicGameT::move.
+ */
+class MoveT {
+    private:
+        uint16_t m_bits;
+
+    public:
+        /**
+         * \brief Default constructor for MoveT, used to fill unused slots of
+         *   a MoveBuffer.
+         *
+         * \details This is a language-specific implementation detail and is
+         * deliberately not in the specification. It should not be used.
+         */
+        MoveT() : m_bits(1) {}
+
+        /**
+         * \brief Constructs a move between two board columns.
+         * \param src Source board column, [0,31].
+         * \param dst Destination board column, [0,31].
+         * \param count Number of cards moved, [1,13].
+         */
+        MoveT(unsigned int src, unsigned int dst, unsigned int count = 1) :
+            m_bits(static_cast<uint16_t>((src << 11) | ((dst & 0x1F) << 6) | (count & 0x3F)))
+        {}
+
+        /**
+         * \brief Gets the source board column.
+         */
+        unsigned int src() const { return m_bits >> 11; }
+
+        /**
+         * \brief Gets the destination board column.
+         */
+        unsigned int dst() const { return (m_bits >> 6) & 0x1F; }
+
+        /**
+         * \brief Gets the number of cards moved.
+         */
+        unsigned int count() const { return m_bits & 0x3F; }
+
+        bool operator==(const MoveT & o) const {
+            return m_bits == o.m_bits;
+        }
+};
+
+
+/**
+ * \brief Throws the exception corresponding to a move status, as
+ *   performMove does for the status of tryMove. Returns if it is MoveOk.
+ */
+inline void throwMoveStatus(MoveStatusT status) {
+    switch (status) {
+        case MoveInvalidPlacement:
+            throw invalid_placement();
+        case MoveEmptySource:
+            throw empty_source();
+        case MoveInvalid:
+            throw invalid_move();
+        case MoveOk:
+            break;
+    }
+}
+
+
+/**
+ * \brief A fixed-capacity, caller-owned list of at most `N` moves.
+ * \details Each BasicGameT variant sizes its buffer so that filling it never
+ *   overflows or allocates; see BasicGameT::MoveBufferT.
+ */
+template <unsigned int N>
+class BasicMoveBuffer {
+    private:
+        std::array<MoveT, N> m_moves;
+        unsigned int m_size;
+
+    public:
+        /**
+         * \brief The most moves the buffer can hold.
+         */
+        static constexpr unsigned int Capacity = N;
+
+        BasicMoveBuffer() : m_size(0) {}
+
+        /**
+         * \brief Returns the number of moves in the buffer.
+         */
+        unsigned int size() const { return m_size; }
+
+        /**
+         * \brief Returns true if the buffer has no moves in it.
+         */
+        bool isEmpty() const { return m_size == 0; }
+
+        /**
+         * \brief Removes all moves from the buffer.
+         */
+        void clear() { m_size = 0; }
+
+        /**
+         * \brief Appends a move. The buffer must not be full.
+         */
+        void push(MoveT m) { m_moves[m_size++] = m; }
+
+        /**
+         * \brief Appends a single card move from board column `s` to each
+         *   board column whose bit is set in `dsts`, lowest column first.
+         *   The buffer must have room for them.
+         */
+        void pushAll(unsigned int s, uint32_t dsts) {
+            for (; dsts != 0; dsts &= dsts - 1) {
+                m_moves[m_size++] = MoveT(s, __builtin_ctz(dsts));
+            }
+        }
+
+        const MoveT & operator[](unsigned int k) const { return m_moves[k]; }
+        const MoveT * begin() const { return m_moves.data(); }
+        const MoveT * end() const { return m_moves.data() + m_size; }
+};
+
+
+/**
+ * \brief The move buffer of a GameT.
+ * \details Large enough to hold a single card move between every ordered
+ *   pair of distinct board columns, plus a supermove of every length from 2
+ *   to 13 between every ordered pair of distinct cascades.
+ */
+typedef BasicMoveBuffer<16 * 15 + 8 * 7 * 12> MoveBuffer;
+
+#endif
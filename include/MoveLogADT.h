@@ -0,0 +1,164 @@
+/**
+ * \file MoveLogADT.h
+ * \author agent <agent@local>
+ * \brief Provides a compact streaming format for logs of played games and a
+ *   replayer applying them to GameT.
+ */
+#ifndef MOVE_LOG_ADT_H
+#define MOVE_LOG_ADT_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "MappedFileADT.h"
+#include "MoveADT.h"
+
+
+/**
+ * \brief Packs a move into one byte, the source column in the high nibble
+ *   and the destination column in the low nibble, preceded by an escape
+ *   byte if it is a supermove.
+ * \details A byte whose nibbles are equal would be a move from a column to
+ *   itself, so such bytes serve as escape codes: an escape byte with both
+ *   nibbles `k` makes the move after it move `k + 2` cards.
+ * \return The number of bytes written to `out`, 1 or 2.
+ */
+inline unsigned int packMove(MoveT m, unsigned char * out) {
+    unsigned int n = 0;
+    if (m.count() > 1) {
+        unsigned int k = m.count() - 2;
+        out[n++] = static_cast<unsigned char>((k << 4) | k);
+    }
+    out[n++] = static_cast<unsigned char>((m.src() << 4) | m.dst());
+    return n;
+}
+
+/**
+ * \brief Determines whether a packed move byte is an escape code.
+ */
+inline bool isEscape(unsigned char b) {
+    return (b >> 4) == (b & 0x0F);
+}
+
+/**
+ * \brief Unpacks a move packed by packMove from the bytes [p, end).
+ * \return The number of bytes read, or 0 if the bytes do not start with a
+ *   packed move.
+ */
+inline unsigned int unpackMove(const unsigned char * p, const unsigned char * end, MoveT & m) {
+    if (p == end) {
+        return 0;
+    }
+    if (!isEscape(p[0])) {
+        m = MoveT(p[0] >> 4, p[0] & 0x0F);
+        return 1;
+    }
+    if (end - p < 2 || isEscape(p[1])) {
+        return 0;
+    }
+    m = MoveT(p[1] >> 4, p[1] & 0x0F, (p[0] & 0x0F) + 2);
+    return 2;
+}
+
+
+/**
+ * \brief One game of a move log. The moves are packed by packMove.
+ */
+struct MoveLogRecordT {
+    uint64_t seed;                ///< Seed the game was dealt from.
+    DealT mode;                   ///< Dealing algorithm of the seed.
+    uint32_t length;              ///< Length of the packed moves in bytes.
+    const unsigned char * moves;  ///< The packed moves.
+};
+
+
+/**
+ * \brief Writes a move log readable by MoveLogReaderT.
+ * \details The file starts with the 8 byte magic "FCMLOG01". Each game
+ *   follows as a 13 byte header (the DealT, the 8 byte seed and the 4 byte
+ *   length of its moves, little-endian) and then its moves packed by
+ *   packMove.
+ */
+class MoveLogWriterT {
+    private:
+        std::ofstream m_out;
+
+    public:
+        /**
+         * \brief Creates or truncates the file at `path`.
+         * \throws io_error if the file cannot be opened.
+         */
+        MoveLogWriterT(const std::string & path);
+
+        /**
+         * \brief Appends a game to the log.
+         * \details Games are buffered: the log is only complete once
+         *   closed.
+         * \throws io_error if the write fails.
+         */
+        void write(uint64_t seed, DealT mode, const std::vector<MoveT> & moves);
+
+        /**
+         * \brief Flushes and closes the log. Destroying the writer closes
+         *   the log as well, but cannot report a failure.
+         * \throws io_error if the buffered games cannot be written.
+         */
+        void close();
+};
+
+
+/**
+ * \brief A move log mapped read-only into memory and read one game at a
+ *   time.
+ * \details Records point straight into the mapping; reading never copies
+ *   or allocates.
+ */
+class MoveLogReaderT {
+    private:
+        MappedFileT m_file;
+        unsigned long m_offset;
+
+        MoveLogReaderT(const MoveLogReaderT &);
+        MoveLogReaderT & operator=(const MoveLogReaderT &);
+
+    public:
+        /**
+         * \brief Maps the file at `path`.
+         * \throws io_error if the file cannot be mapped or does not start
+         *   with the move log magic.
+         */
+        MoveLogReaderT(const std::string & path);
+
+        /**
+         * \brief Reads the next game of the log.
+         * \return False at the end of the log.
+         * \throws io_error if the log ends part way through a game or the
+         *   record names an unknown kind of deal.
+         */
+        bool next(MoveLogRecordT & r);
+};
+
+
+/**
+ * \brief Applies the moves packed in `length` bytes to a game in order.
+ * \param validate If false the moves are trusted and applied with
+ *   GameT::applyTrusted, skipping all checks but those of the packing.
+ * \param applied Receives the number of moves made.
+ * \return MoveOk if every move was made, otherwise the status of the first
+ *   move which could not be. Malformed packing is reported as MoveInvalid.
+ */
+MoveStatusT replayMoves(GameT & g, const unsigned char * moves, unsigned long length,
+                        bool validate, unsigned long & applied);
+
+/**
+ * \brief Deals the game of a log record and replays its moves onto it.
+ * \details The moves are journaled if `g` was journaling.
+ * \return As for replayMoves.
+ */
+MoveStatusT replay(const MoveLogRecordT & r, GameT & g, bool validate = true);
+
+#endif
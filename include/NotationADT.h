@@ -0,0 +1,159 @@
+/**
+ * \file NotationADT.h
+ * \author agent <agent@local>
+ * \brief Provides parsing and formatting of boards and moves in the text
+ *   notation common to FreeCell tools.
+ * \details Cards are a rank (A, 2-9, T, J, Q, K) followed by a suit (S, C,
+ *   H, D), e.g. "KS" or "TH". "10" is also accepted for ten. A board is
+ *   written as:
+ *
+ *       Foundations: S-0 C-2 H-A D-0
+ *       Freecells: KS - - -
+ *       : 5C 9D QH ...
+ *
+ *   with one cascade line per cascade, bottom card first. The Foundations
+ *   and Freecells lines and the leading colons are optional. A move names
+ *   its source and destination: 1-8 for cascades, a-d for cells and h for
+ *   the foundations, e.g. "3a", "ah" or "1h". A supermove between cascades
+ *   is suffixed with the number of cards it moves, e.g. "373" moves three
+ *   cards from the third cascade to the seventh.
+ */
+#ifndef NOTATION_ADT_H
+#define NOTATION_ADT_H
+
+#include <array>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "CardADT.h"
+#include "GameADT.h"
+#include "MoveADT.h"
+
+
+/**
+ * \brief Parses a card such as "KS" from the characters [begin, end).
+ * \throws invalid_notation if the characters are not exactly one card.
+ */
+CardCodeT parseCard(const char * begin, const char * end);
+
+/**
+ * \brief Appends the notation of a card to `out`.
+ */
+void formatCard(CardCodeT c, std::string & out);
+
+
+/**
+ * \brief Parses a move such as "3a" from the characters [begin, end).
+ * \details The notation names the foundations only as a whole, so "h" is
+ *   resolved against `g` to the first foundation for which the move is
+ *   valid, or to the first foundation if there is none.
+ * \throws invalid_notation if the characters are not exactly one move.
+ */
+MoveT parseMove(const GameT & g, const char * begin, const char * end);
+
+/**
+ * \brief Appends the notation of a move to `out`.
+ */
+void formatMove(MoveT m, std::string & out);
+
+/**
+ * \brief Parses a sequence of moves separated by whitespace, played from
+ *   `g`, replacing the contents of `out`.
+ * \throws invalid_notation if a move is malformed.
+ * \throws invalid_move if a move is not valid where it is played.
+ */
+void parseMoves(const GameT & g, const std::string & text, std::vector<MoveT> & out);
+
+/**
+ * \brief Appends the notation of a sequence of moves to `out`, separated by
+ *   spaces.
+ */
+void formatMoves(const std::vector<MoveT> & moves, std::string & out);
+
+
+/**
+ * \brief Assembles a board from its notation one line at a time.
+ * \details Blank lines and lines starting with '#' are skipped, so boards
+ *   in a file may be separated by either. A board is complete after its
+ *   eighth cascade line.
+ */
+class BoardParserT {
+    private:
+        std::array<ColumnT, 16> m_cols;
+        unsigned int m_cascades;
+        unsigned int m_cells;
+
+    public:
+        /**
+         * \brief Constructs a parser expecting the first line of a board.
+         */
+        BoardParserT();
+
+        /**
+         * \brief Discards any partially parsed board.
+         */
+        void reset();
+
+        /**
+         * \brief Parses one line, given as the characters [begin, end)
+         *   without the line break.
+         * \return True if the line completed a board, which game() returns.
+         * \throws invalid_notation if the line is malformed, or if a board
+         *   was completed and game() has not been called since.
+         */
+        bool feed(const char * begin, const char * end);
+
+        /**
+         * \brief Returns the board completed by feed and readies the parser
+         *   for the next.
+         * \throws invalid_board if the board does not hold each of the 52
+         *   cards exactly once.
+         */
+        GameT game();
+};
+
+
+/**
+ * \brief Parses a single board.
+ * \throws invalid_notation if the text is malformed or incomplete.
+ * \throws invalid_board if the board does not hold each of the 52 cards
+ *   exactly once.
+ */
+GameT parseBoard(const std::string & text);
+
+/**
+ * \brief Appends the notation of a board to `out`, including the
+ *   Foundations and Freecells lines.
+ */
+void formatBoard(const GameT & g, std::string & out);
+
+
+/**
+ * \brief Reads the boards of a stream one at a time.
+ * \details Only the current line is held in memory, so files of any number
+ *   of boards can be read.
+ */
+class BoardReaderT {
+    private:
+        std::istream & m_in;
+        std::string m_line;
+        BoardParserT m_parser;
+
+    public:
+        /**
+         * \brief Reads boards from `in`.
+         */
+        BoardReaderT(std::istream & in);
+
+        /**
+         * \brief Reads the next board into `g`.
+         * \return False at the end of the stream.
+         * \throws invalid_notation if the stream is malformed or ends part
+         *   way through a board.
+         * \throws invalid_board as for BoardParserT::game.
+         */
+        bool next(GameT & g);
+};
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * \file PositionDbADT.h
+ * \author agent <agent@local>
+ * \brief Provides an on-disk index of known positions keyed by canonical
+ *   board hash, read through a memory mapping.
+ */
+#ifndef POSITION_DB_ADT_H
+#define POSITION_DB_ADT_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CardADT.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "MappedFileADT.h"
+#include "MoveADT.h"
+
+
+/**
+ * \brief A move described by the cards involved rather than by column
+ *   indices.
+ * \details The database is keyed by canonical hash, so a stored position may
+ *   be a permutation of the board it is looked up for. Naming the moved card
+ *   and the card it lands on keeps the move meaningful for every such
+ *   permutation.
+ */
+struct BestMoveT {
+    CardCodeT card;     ///< The card to move, or the bottom card of the run.
+    uint8_t placement;  ///< PlacementT of the destination.
+    CardCodeT onto;     ///< Top card of the destination, or 0 if it is empty.
+};
+
+/**
+ * \brief Describes a move valid on `g` by the cards it involves.
+ */
+BestMoveT describeMove(const GameT & g, MoveT m);
+
+/**
+ * \brief Finds the move on `g` which a BestMoveT describes.
+ * \return False if the board has no such move.
+ */
+bool resolveMove(const GameT & g, BestMoveT b, MoveT & out);
+
+
+/**
+ * \brief What is known about a position.
+ */
+struct PositionInfoT {
+    bool winnable;      ///< True if the position is known to be winnable.
+    uint16_t distance;  ///< Moves left to win along the best known line.
+    BestMoveT best;     ///< First move of that line. Unset if not winnable.
+};
+
+
+/**
+ * \brief Read-only position database mapped from a file.
+ * \details The file is an open-addressing hash table written by
+ *   PositionDbBuilderT: a 32 byte header followed by a power-of-two number of
+ *   16 byte slots. Lookups probe the mapping directly, never allocate and are
+ *   safe from any number of threads.
+ */
+class PositionDbT {
+    private:
+        MappedFileT m_file;
+        uint64_t m_mask;
+        uint64_t m_count;
+
+        PositionDbT(const PositionDbT &);
+        PositionDbT & operator=(const PositionDbT &);
+
+    public:
+        /**
+         * \brief Maps the database file at `path`.
+         * \throws io_error if the file cannot be mapped or is not a position
+         *   database.
+         */
+        PositionDbT(const std::string & path);
+
+        /**
+         * \brief Looks up a position by canonical hash.
+         * \return False if the position is not in the database.
+         */
+        bool lookup(uint64_t key, PositionInfoT & out) const;
+
+        /**
+         * \brief Looks up the position of a game.
+         * \return False if the position is not in the database.
+         */
+        bool lookup(const GameT & g, PositionInfoT & out) const;
+
+        /**
+         * \brief Returns the number of positions in the database.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Returns the number of slots in the table, for scanning every
+         *   stored position with slot().
+         */
+        unsigned long slots() const;
+
+        /**
+         * \brief Reads slot `k` of the table.
+         * \return False if the slot is empty.
+         */
+        bool slot(unsigned long k, uint64_t & key, PositionInfoT & out) const;
+};
+
+
+/**
+ * \brief Collects positions in memory and writes them as a database file.
+ * \details When the same position is added twice the better record is kept:
+ *   winnable beats not winnable, and a shorter distance beats a longer one.
+ */
+class PositionDbBuilderT {
+    private:
+        std::unordered_map<uint64_t, PositionInfoT> m_positions;
+
+    public:
+        /**
+         * \brief Adds or improves the record of one position.
+         */
+        void add(uint64_t key, const PositionInfoT & info);
+
+        /**
+         * \brief Adds every position along a winning line from `g`, with its
+         *   distance to the win and the next move of the line.
+         */
+        void addSolution(const GameT & g, const std::vector<MoveT> & moves);
+
+        /**
+         * \brief Adds every position of an existing database.
+         */
+        void merge(const PositionDbT & db);
+
+        /**
+         * \brief Returns the number of distinct positions collected.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Writes the database file, replacing `path` atomically.
+         * \throws io_error if the file cannot be written.
+         */
+        void write(const std::string & path) const;
+};
+
+#endif
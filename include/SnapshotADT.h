@@ -0,0 +1,140 @@
+/**
+ * \file SnapshotADT.h
+ * \author agent <agent@local>
+ * \brief Provides a compact fixed-size binary encoding of a board, a view
+ *   which reads it in place, and files of snapshots read by memory mapping.
+ */
+#ifndef SNAPSHOT_ADT_H
+#define SNAPSHOT_ADT_H
+
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "CardADT.h"
+#include "MappedFileADT.h"
+
+
+/**
+ * \brief Size in bytes of a board snapshot.
+ * \details Bytes [0,15] hold the number of cards in each of the 16 board
+ *   columns. Bytes [16,67] hold the 52 card codes, column by column and
+ *   bottom card first within a column.
+ */
+#define SNAPSHOT_SIZE 68
+
+/**
+ * \brief An owned board snapshot, as written by GameT::snapshot.
+ */
+typedef std::array<unsigned char, SNAPSHOT_SIZE> SnapshotT;
+
+
+/**
+ * \brief Read-only view of a snapshot held anywhere in memory, for example
+ *   in a memory-mapped file. Reading a column never copies the snapshot.
+ */
+class SnapshotViewT {
+    private:
+        const unsigned char * m_p;
+
+    public:
+        /**
+         * \brief Views the SNAPSHOT_SIZE bytes starting at `p`.
+         */
+        explicit SnapshotViewT(const unsigned char * p);
+
+        /**
+         * \brief Views an owned snapshot, which must outlive the view.
+         */
+        explicit SnapshotViewT(const SnapshotT & s);
+
+        /**
+         * \brief Returns the number of cards in board column `col`.
+         */
+        unsigned int length(unsigned int col) const;
+
+        /**
+         * \brief Returns the `k`th card from the bottom of board column
+         *   `col`.
+         */
+        CardCodeT card(unsigned int col, unsigned int k) const;
+
+        /**
+         * \brief Returns the top card of board column `col`, which must not
+         *   be empty.
+         */
+        CardCodeT top(unsigned int col) const;
+
+        /**
+         * \brief Returns the start of the viewed bytes.
+         */
+        const unsigned char * data() const;
+};
+
+
+/**
+ * \brief Writes a file of snapshots readable by SnapshotFileT.
+ * \details The file starts with the 8 byte magic "FCSNAP01" followed by
+ *   the snapshots back to back.
+ */
+class SnapshotWriterT {
+    private:
+        std::ofstream m_out;
+
+    public:
+        /**
+         * \brief Creates or truncates the file at `path`.
+         * \throws io_error if the file cannot be opened.
+         */
+        SnapshotWriterT(const std::string & path);
+
+        /**
+         * \brief Appends a snapshot to the file.
+         * \details Snapshots are buffered: the file is only complete once
+         *   closed.
+         * \throws io_error if the write fails.
+         */
+        void write(const SnapshotT & s);
+
+        /**
+         * \brief Flushes and closes the file. Destroying the writer closes
+         *   the file as well, but cannot report a failure.
+         * \throws io_error if the buffered snapshots cannot be written.
+         */
+        void close();
+};
+
+
+/**
+ * \brief A file of snapshots mapped read-only into memory.
+ * \details Snapshots are read straight out of the mapping through
+ *   SnapshotViewT, so scanning a file never deserializes it. Safe to read
+ *   from many threads.
+ */
+class SnapshotFileT {
+    private:
+        MappedFileT m_file;
+
+        SnapshotFileT(const SnapshotFileT &);
+        SnapshotFileT & operator=(const SnapshotFileT &);
+
+    public:
+        /**
+         * \brief Maps the file at `path`.
+         * \throws io_error if the file cannot be mapped or does not start
+         *   with the snapshot magic.
+         */
+        SnapshotFileT(const std::string & path);
+
+        /**
+         * \brief Returns the number of snapshots in the file.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Returns a view of the `k`th snapshot.
+         */
+        SnapshotViewT operator[](unsigned long k) const;
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * \file SolverADT.h
+ * \author agent <agent@local>
+ * \brief Provides a best-first search which finds a sequence of moves
+ *   winning a game of FreeCell.
+ */
+#ifndef SOLVER_ADT_H
+#define SOLVER_ADT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "GameADT.h"
+#include "MoveADT.h"
+#include "TranspositionADT.h"
+
+
+/**
+ * \brief An estimate of the number of moves left to win from a state. Lower
+ *   is better.
+ */
+typedef unsigned int (*HeuristicT)(const GameT & g);
+
+/**
+ * \brief Counts the cards which are not on a foundation.
+ * \details Every such card needs at least one more move, so this never
+ *   overestimates and with a weight of 1 the solver finds shortest solutions.
+ */
+unsigned int cardsOutside(const GameT & g);
+
+/**
+ * \brief Counts the cards which are not on a foundation, plus the cards in
+ *   each cascade which sit above the lowest card of that cascade.
+ * \details Not admissible, but guides the search to a solution much faster
+ *   than cardsOutside. The default heuristic.
+ */
+unsigned int cardsOutsideAndBlocking(const GameT & g);
+
+
+/**
+ * \brief Describes how a search ended.
+ */
+enum SolveStatusT {
+    Solved,      ///< A winning sequence of moves was found.
+    Unsolvable,  ///< Every reachable state was searched without a win.
+    NodeLimit,   ///< The search stopped after generating its node budget.
+    TimeLimit    ///< The search stopped after running out of time.
+};
+
+
+/**
+ * \brief Parameters of a search.
+ */
+struct SolverConfigT {
+    HeuristicT heuristic;    ///< Estimate of the moves left to win.
+    unsigned int weight;     ///< Weight of the heuristic over the moves made so far. 1 is A*.
+    unsigned long maxNodes;  ///< Budget of generated states.
+    double maxSeconds;       ///< Budget of wall clock time. 0 for no limit.
+    unsigned int threads;    ///< Cap on ParallelSolverT workers. 0 for one per hardware thread.
+    bool supermoves;         ///< Whether a run of cards may be moved in one ply. Off by default, as the wider branching outweighs the shallower solutions.
+    bool autoplay;           ///< Whether safe cards go to the foundations after every move, without a ply of their own. On by default.
+
+    SolverConfigT();
+};
+
+
+/**
+ * \brief The outcome of a search.
+ */
+struct SolveResultT {
+    SolveStatusT status;
+    std::vector<MoveT> moves;  ///< The winning moves if Solved, including those made by autoplay.
+    unsigned long nodes;       ///< States generated.
+    double seconds;            ///< Wall clock time spent.
+
+    /**
+     * \brief Returns the search throughput in generated states per second.
+     */
+    double nodesPerSecond() const;
+};
+
+
+/**
+ * \brief A search node: the move leading to a state from its parent.
+ * \details The state itself is not stored. It is recovered by walking a
+ *   working board along the moves from a node it is already at.
+ */
+struct SearchNodeT {
+    uint32_t parent;  ///< Index of the parent node. The root is its own parent.
+    MoveT move;       ///< The move from the parent state to this state.
+    uint16_t depth;   ///< Number of moves from the root.
+};
+
+
+/**
+ * \brief Best-first search over the states of a GameT.
+ * \details States are expanded in order of `depth + weight * heuristic`.
+ *   Rather than storing a board per search node, a node only records its
+ *   parent and the move leading to it; the solver walks a single working
+ *   board between nodes using GameT's undo journal. Visited states are
+ *   detected by their canonical hash.
+ *
+ *   All buffers are sized from the node budget up front and reused by later
+ *   searches, so a SolverT should be kept and reused rather than constructed
+ *   per deal.
+ */
+class SolverT {
+    private:
+        struct OpenT {
+            uint64_t priority;
+            uint32_t node;
+
+            bool operator<(const OpenT & o) const {
+                return priority > o.priority;
+            }
+        };
+
+        SolverConfigT m_config;
+        TranspositionTableT m_seen;
+        std::vector<SearchNodeT> m_nodes;
+        std::vector<OpenT> m_open;
+        std::vector<MoveT> m_path;
+        MoveBuffer m_moves;
+        GameT m_game;
+        uint32_t m_at;
+
+    public:
+        /**
+         * \brief Constructs a solver, allocating its buffers for the node
+         *   budget of the configuration.
+         */
+        SolverT(const SolverConfigT & config = SolverConfigT());
+
+        /**
+         * \brief Searches for a winning sequence of moves from `g`.
+         * \return The outcome, including the moves if one was found.
+         */
+        SolveResultT solve(const GameT & g);
+};
+
+
+/**
+ * \brief Multi-threaded search over the states of a GameT.
+ * \details Each worker owns a deque of nodes to expand and its own working
+ *   board. A worker expands the most recently pushed node of its own deque,
+ *   pushing the children best-last so it dives towards the most promising
+ *   one; idle workers steal the oldest node from another worker's deque,
+ *   which tends to be the root of the largest unexplored subtree. All
+ *   workers share one node arena, sized to the node budget up front, and a
+ *   lock-free transposition table.
+ *
+ *   The moves found are a solution but, unlike SolverT with a weight of 1,
+ *   not necessarily a shortest one.
+ */
+class ParallelSolverT {
+    private:
+        struct WorkerT;
+
+        SolverConfigT m_config;
+        unsigned int m_threads;
+        ConcurrentTranspositionTableT m_seen;
+        std::vector<SearchNodeT> m_nodes;
+        std::vector<std::unique_ptr<WorkerT>> m_workers;
+
+        std::atomic<uint32_t> m_count;
+        std::atomic<unsigned int> m_idle;
+        std::atomic<bool> m_stop;
+        std::mutex m_resultLock;
+        SolveStatusT m_status;
+        uint32_t m_won;
+        std::chrono::steady_clock::time_point m_deadline;
+
+        /**
+         * \brief The loop run by worker `w` until the search stops.
+         */
+        void work(unsigned int w);
+
+        /**
+         * \brief Takes a node from the worker's own deque, or steals one
+         *   from another worker.
+         * \return False if no work was found.
+         */
+        bool take(unsigned int w, uint32_t & n);
+
+        /**
+         * \brief Stops every worker, recording why.
+         */
+        void finish(SolveStatusT status, uint32_t won);
+
+    public:
+        /**
+         * \brief Constructs a solver, allocating the node arena and table
+         *   for the node budget of the configuration.
+         */
+        ParallelSolverT(const SolverConfigT & config = SolverConfigT());
+
+        ~ParallelSolverT();
+
+        /**
+         * \brief Returns the number of worker threads used by solve().
+         */
+        unsigned int threads() const;
+
+        /**
+         * \brief Searches for a winning sequence of moves from `g` using all
+         *   worker threads.
+         * \return The outcome, including the moves if one was found.
+         */
+        SolveResultT solve(const GameT & g);
+};
+
+#endif
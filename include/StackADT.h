@@ -10,14 +10,58 @@
 #include <vector>
 
 
+/**
+ * \brief Fixed-size storage for up to `N` items held inline, without any heap
+ *   allocation.
+ * \details Implementation detail of Stack. Exposes the subset of the
+ *   std::vector interface which Stack relies on.
+ */
+template <class T, int N>
+class InlineStorage {
+    private:
+        T m_items[N];
+        int m_size;
+
+    public:
+        InlineStorage() : m_size(0) {}
+
+        unsigned int size() const { return m_size; }
+        unsigned int capacity() const { return N; }
+        const T * data() const { return m_items; }
+        const T & back() const { return m_items[m_size - 1]; }
+        void push_back(const T & v) { m_items[m_size++] = v; }
+        void pop_back() { m_size--; }
+        const T * cbegin() const { return m_items; }
+        const T * cend() const { return m_items + m_size; }
+};
+
+
+/**
+ * \brief Selects the storage of a Stack. A bound of 0 selects a std::vector,
+ *   any other bound selects InlineStorage.
+ */
+template <class T, int N>
+struct StackStorage {
+    typedef InlineStorage<T, N> type;
+};
+
+template <class T>
+struct StackStorage<T, 0> {
+    typedef std::vector<T> type;
+};
+
+
 /**
  * \brief ADT for a first-in-last-out data structure with an optionally bounded
  *   capacity.
+ * \details When `N` is non-zero the items are stored inline in the Stack
+ *   itself and the capacity given at construction may not exceed `N`. Copying
+ *   such a Stack never allocates.
  */
-template <class T>
+template <class T, int N = 0>
 class Stack {
     private:
-        std::vector<T> m_s;
+        typename StackStorage<T, N>::type m_s;
         int m_capacity;
 
     public:
@@ -35,7 +79,7 @@ class Stack {
          * \param capacity The maximum number of items which can be in this
          *   stack.
          * \throws invalid_capacity if the capacity is not a natural number
-         *   greater than 0.
+         *   greater than 0, or exceeds the inline bound `N` when one is set.
          */
         Stack(int capacity);
 
@@ -54,6 +98,11 @@ class Stack {
          */
         int capacity() const;
 
+        /**
+         * \brief Returns the number of items in this stack.
+         */
+        int size() const;
+
         /**
          * \brief Adds an item to the stack.
          * \param v The item to add to the top of the stack.
@@ -81,6 +130,18 @@ class Stack {
          * \returns A copy of the sequence.
          */
         std::vector<T> seq() const;
+
+        /**
+         * \brief Returns a pointer to the first item inserted, for iterating
+         *   over the members in the same order as seq() without copying.
+         * \details Invalidated by any change to the stack.
+         */
+        const T * begin() const;
+
+        /**
+         * \brief Returns a pointer past the last item inserted.
+         */
+        const T * end() const;
 };
 
 #endif
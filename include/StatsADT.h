@@ -0,0 +1,169 @@
+/**
+ * \file StatsADT.h
+ * \author agent <agent@local>
+ * \brief Provides opt-in counters of the calls made to the public GameT and
+ *   Stack APIs and of the heap allocations they perform.
+ * \details Counting is compiled in only when FREECELL_STATS is defined (e.g.
+ *   `make STATS=1`). Otherwise the instrumentation expands to nothing and
+ *   stats() reports zeros.
+ *
+ *   Counters are kept per thread, so a thread playing or solving a game can
+ *   read its own cost without contention. An allocation is charged to the
+ *   outermost instrumented call on the thread, i.e. the call made by the
+ *   user: the journal entry appended when performMove() calls tryMove() is
+ *   charged to StatGamePerformMove.
+ */
+#ifndef STATS_ADT_H
+#define STATS_ADT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+ * \brief The instrumented API calls.
+ */
+enum StatApiT {
+    StatStackPush,
+    StatStackPeek,
+    StatStackPop,
+    StatStackSeq,
+    StatGameConstruct,     ///< Any GameT constructor other than the copy and move constructors.
+    StatGameCopyConstruct,
+    StatGameCopyAssign,
+    StatGameSnapshot,
+    StatGameGetCol,
+    StatGameIsValidMove,
+    StatGameNoValidMoves,
+    StatGameCheckMove,     ///< Both overloads.
+    StatGameTryMove,       ///< Both overloads.
+    StatGamePerformMove,   ///< Both overloads.
+    StatGameApplyTrusted,
+    StatGameGenerateMoves,
+    StatGameAutoplay,
+    StatGameUndoMove,
+    StatGameRedoMove,
+    StatGameRewind,
+    StatGameHistory,
+    StatApiCount
+};
+
+
+/**
+ * \brief The counters of one instrumented API call.
+ */
+struct ApiStatsT {
+    uint64_t calls;        ///< Number of calls, including calls made by the library itself.
+    uint64_t allocations;  ///< Heap allocations performed by the call, unless made within another instrumented call.
+    uint64_t bytes;        ///< Bytes requested by those allocations.
+};
+
+
+/**
+ * \brief The counters of every instrumented API call on a thread.
+ */
+struct StatsT {
+    std::array<ApiStatsT, StatApiCount> api;
+
+    /**
+     * \brief Returns the counters of one API call.
+     */
+    const ApiStatsT & operator[](StatApiT a) const { return api[a]; }
+
+    /**
+     * \brief Returns the counters summed over every API call.
+     */
+    ApiStatsT total() const;
+};
+
+
+/**
+ * \brief Returns true if the library was built with FREECELL_STATS.
+ */
+bool statsEnabled();
+
+/**
+ * \brief Returns a copy of the calling thread's counters.
+ */
+StatsT stats();
+
+/**
+ * \brief Zeroes the calling thread's counters.
+ */
+void resetStats();
+
+/**
+ * \brief Returns the name of an API call, e.g. "GameT::performMove".
+ */
+const char * statName(StatApiT a);
+
+
+#ifdef FREECELL_STATS
+
+/**
+ * \brief Counts a call and, if no other instrumented call is in progress on
+ *   the thread, marks it as the one to charge allocations to.
+ * \details Implementation detail of the STAT_CALL macro.
+ */
+class StatScopeT {
+    private:
+        int m_outer;
+
+    public:
+        StatScopeT(StatApiT a);
+        ~StatScopeT();
+};
+
+/**
+ * \brief Charges an allocation of `bytes` to the outermost instrumented call.
+ *   Allocations of 0 bytes are ignored.
+ */
+void statAlloc(std::size_t bytes);
+
+#define STAT_CALL(a) StatScopeT statScope_(a)
+#define STAT_ALLOC(bytes) statAlloc(bytes)
+
+#else
+
+#define STAT_CALL(a) ((void)0)
+#define STAT_ALLOC(bytes) ((void)0)
+
+#endif
+
+
+/**
+ * \brief Appends `x` to a vector-like container, charging the allocation to
+ *   the outermost instrumented call if the container grows its buffer.
+ */
+template <class V, class T>
+inline void statPushBack(V & v, const T & x) {
+#ifdef FREECELL_STATS
+    std::size_t capacity = v.capacity();
+    v.push_back(x);
+    if (v.capacity() != capacity) {
+        statAlloc(v.capacity() * sizeof(T));
+    }
+#else
+    v.push_back(x);
+#endif
+}
+
+/**
+ * \brief Copies the vector-like container `x` into `v`, charging the
+ *   allocation to the outermost instrumented call if `v` grows its buffer.
+ */
+template <class V>
+inline void statAssign(V & v, const V & x) {
+#ifdef FREECELL_STATS
+    std::size_t capacity = v.capacity();
+    v = x;
+    if (v.capacity() != capacity) {
+        statAlloc(v.capacity() * sizeof(typename V::value_type));
+    }
+#else
+    v = x;
+#endif
+}
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * \file TranspositionADT.h
+ * \author agent <agent@local>
+ * \brief Provides a fixed-capacity set of board hashes for detecting
+ *   positions which have already been visited during a search.
+ */
+#ifndef TRANSPOSITION_ADT_H
+#define TRANSPOSITION_ADT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+/**
+ * \brief The outcome of adding a hash to a transposition table.
+ */
+enum InsertStatusT {
+    InsertOk,         ///< The hash was added.
+    InsertDuplicate,  ///< The hash was already in the set.
+    InsertFull        ///< The hash is new but the table has no room for it.
+};
+
+
+/**
+ * \brief Open-addressing hash set of 64-bit board hashes.
+ * \details The table is allocated once at construction and never grows;
+ *   clearing it keeps the allocation for the next search.
+ */
+class TranspositionTableT {
+    private:
+        std::vector<uint64_t> m_slots;
+        uint64_t m_mask;
+        unsigned long m_size;
+
+    public:
+        /**
+         * \brief Constructs a table able to hold at least `capacity` hashes.
+         * \details The number of slots is the next power of two of at least
+         *   twice the capacity, which keeps probe sequences short.
+         * \throws invalid_capacity if the capacity is 0.
+         */
+        TranspositionTableT(unsigned long capacity);
+
+        /**
+         * \brief Adds a hash to the set.
+         * \return InsertOk if the hash was added, InsertDuplicate if it was
+         *   already in the set, or InsertFull if it is new but the set
+         *   already holds capacity() hashes.
+         */
+        InsertStatusT insert(uint64_t h);
+
+        /**
+         * \brief Returns true if the hash is in the set.
+         */
+        bool contains(uint64_t h) const;
+
+        /**
+         * \brief Returns the number of hashes in the set.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Returns the maximum number of hashes the set can hold.
+         */
+        unsigned long capacity() const;
+
+        /**
+         * \brief Removes all hashes from the set.
+         */
+        void clear();
+};
+
+
+/**
+ * \brief Lock-free counterpart of TranspositionTableT which many threads can
+ *   insert into concurrently.
+ * \details Each slot is claimed with a single compare-and-swap; hashes are
+ *   never removed while the table is shared, so a probe which reaches an
+ *   empty slot knows the hash is absent.
+ */
+class ConcurrentTranspositionTableT {
+    private:
+        std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+        uint64_t m_mask;
+        std::atomic<unsigned long> m_size;
+
+    public:
+        /**
+         * \brief Constructs a table able to hold at least `capacity` hashes.
+         * \throws invalid_capacity if the capacity is 0.
+         */
+        ConcurrentTranspositionTableT(unsigned long capacity);
+
+        /**
+         * \brief Adds a hash to the set. Safe to call from many threads.
+         * \return InsertOk if this call added the hash, InsertDuplicate if
+         *   it was already in the set, or InsertFull if it is new but the
+         *   set already holds capacity() hashes.
+         */
+        InsertStatusT insert(uint64_t h);
+
+        /**
+         * \brief Returns true if the hash is in the set.
+         */
+        bool contains(uint64_t h) const;
+
+        /**
+         * \brief Returns the number of hashes in the set.
+         */
+        unsigned long size() const;
+
+        /**
+         * \brief Returns the maximum number of hashes the set can hold.
+         */
+        unsigned long capacity() const;
+
+        /**
+         * \brief Removes all hashes from the set. Must not run concurrently
+         *   with any other member function.
+         */
+        void clear();
+};
+
+#endif
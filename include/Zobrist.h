@@ -0,0 +1,41 @@
+/**
+ * \file Zobrist.h
+ * \author agent <agent@local>
+ * \brief Provides the random keys used to hash FreeCell board states.
+ */
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+#include "CardADT.h"
+
+
+/**
+ * \brief Gets the key for a card at a given depth within a column.
+ * \param c The packed card.
+ * \param depth The number of cards beneath it in its column, in [0,18].
+ */
+uint64_t zobristKey(CardCodeT c, unsigned int depth);
+
+/**
+ * \brief Gets a salt distinguishing a value from others of the same kind.
+ * \param k Any value in [0,31], e.g. a board column.
+ */
+uint64_t zobristSalt(unsigned int k);
+
+/**
+ * \brief A bijective finalizer spreading every input bit over the output.
+ * \details Used to combine per-column hashes so that the combination does
+ *   not cancel out the way a plain exclusive-or of column hashes would.
+ */
+inline uint64_t zobristMix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+#endif
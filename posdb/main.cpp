@@ -0,0 +1,154 @@
+// Builds and queries position databases (see PositionDbADT.h).
+//
+// Usage:
+//
+//   posdb add DB FIRST LAST [THREADS] [SECONDS] [NODES]
+//     Solves Microsoft FreeCell deals FIRST to LAST and adds every position
+//     along each winning line, and the start of each deal proven unsolvable,
+//     to DB. An existing DB is kept and extended. Deals which run out of
+//     budget are left out: only a search which was not limited proves a
+//     deal unsolvable.
+//
+//   posdb merge OUT IN...
+//     Merges databases into OUT, which may be one of the inputs.
+//
+//   posdb query DB FIRST [LAST]
+//     Prints what DB knows about the start of each deal:
+//
+//       seed  status  distance
+//
+// THREADS defaults to one per hardware thread, SECONDS is the time budget
+// per deal (default 10) and NODES the node budget per deal (default 2000000).
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "PositionDbADT.h"
+#include "SolverADT.h"
+
+
+static void usage(const char * name) {
+    std::cerr << "usage: " << name << " add DB FIRST LAST [THREADS] [SECONDS] [NODES]" << std::endl
+              << "       " << name << " merge OUT IN..." << std::endl
+              << "       " << name << " query DB FIRST [LAST]" << std::endl;
+}
+
+
+// Adds the database at `path` to `b`, if there is one.
+static void mergeExisting(PositionDbBuilderT & b, const std::string & path) {
+    if (access(path.c_str(), F_OK) == 0) {
+        PositionDbT db(path);
+        b.merge(db);
+    }
+}
+
+
+static int add(int argc, char ** argv) {
+    std::string path = argv[2];
+    unsigned long long first = std::strtoull(argv[3], 0, 10);
+    unsigned long long last = std::strtoull(argv[4], 0, 10);
+    unsigned int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    SolverConfigT config;
+    config.maxSeconds = argc > 6 ? std::atof(argv[6]) : 10;
+    config.maxNodes = argc > 7 ? std::strtoul(argv[7], 0, 10) : 2000000;
+
+    PositionDbBuilderT builder;
+    mergeExisting(builder, path);
+
+    std::atomic<unsigned long long> next(first);
+    std::atomic<unsigned long> solved(0);
+    std::mutex lock;
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.push_back(std::thread([&]() {
+            SolverT solver(config);
+            for (unsigned long long seed = next++; seed <= last; seed = next++) {
+                GameT g(seed, MicrosoftDeal);
+                SolveResultT r = solver.solve(g);
+                std::lock_guard<std::mutex> guard(lock);
+                if (r.status == Solved) {
+                    builder.addSolution(g, r.moves);
+                    solved++;
+                } else if (r.status == Unsolvable && r.nodes < config.maxNodes) {
+                    // A search cut short by its budget proves nothing.
+                    PositionInfoT info = { false, 0, BestMoveT() };
+                    builder.add(g.canonicalHash(), info);
+                }
+            }
+        }));
+    }
+    for (std::thread &t : pool) {
+        t.join();
+    }
+
+    builder.write(path);
+    std::cout << solved << " deals solved, " << builder.size() << " positions" << std::endl;
+    return 0;
+}
+
+
+static int merge(int argc, char ** argv) {
+    PositionDbBuilderT builder;
+    for (int k = 3; k < argc; k++) {
+        PositionDbT db(argv[k]);
+        builder.merge(db);
+    }
+    builder.write(argv[2]);
+    std::cout << builder.size() << " positions" << std::endl;
+    return 0;
+}
+
+
+static int query(int argc, char ** argv) {
+    PositionDbT db(argv[2]);
+    unsigned long long first = std::strtoull(argv[3], 0, 10);
+    unsigned long long last = argc > 4 ? std::strtoull(argv[4], 0, 10) : first;
+
+    for (unsigned long long seed = first; seed <= last; seed++) {
+        PositionInfoT info;
+        std::cout << seed << '\t';
+        if (!db.lookup(GameT(seed, MicrosoftDeal), info)) {
+            std::cout << "unknown" << std::endl;
+        } else if (info.winnable) {
+            std::cout << "winnable\t" << info.distance << std::endl;
+        } else {
+            std::cout << "unsolvable" << std::endl;
+        }
+    }
+    return 0;
+}
+
+
+int main(int argc, char ** argv) {
+    std::string command = argc > 1 ? argv[1] : "";
+    try {
+        if (command == "add" && argc >= 5) {
+            return add(argc, argv);
+        }
+        if (command == "merge" && argc >= 4) {
+            return merge(argc, argv);
+        }
+        if (command == "query" && argc >= 4) {
+            return query(argc, argv);
+        }
+    } catch (const io_error &) {
+        std::cerr << argv[0] << ": cannot read or write position database" << std::endl;
+        return 1;
+    }
+
+    usage(argv[0]);
+    return 1;
+}
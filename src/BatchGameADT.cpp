@@ -0,0 +1,223 @@
+/**
+ * \file BatchGameADT.cpp
+ * \author agent <agent@local>
+ */
+#include <array>
+#include <vector>
+
+#include "BatchGameADT.h"
+#include "Exceptions.h"
+
+
+template <class V>
+BasicBatchGameT<V>::BasicBatchGameT(unsigned int boards) :
+    m_boards(boards),
+    m_cards(Columns * Depth * boards, 0),
+    m_sizes(Columns * boards, 0),
+    m_tops(Columns * boards, 0),
+    m_heights(boards, 0)
+{}
+
+
+template <class V>
+unsigned int BasicBatchGameT<V>::size() const {
+    return m_boards;
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::checkBoard(unsigned int b) const {
+    if (b >= m_boards) {
+        throw invalid_placement();
+    }
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::load(unsigned int b, const GameType & g) {
+    checkBoard(b);
+    for (unsigned int x = 0; x < Columns; x++) {
+        PlacementT p = GameType::placement(x);
+        const ColumnT &col = g.getCol(p, x - GameType::column(p, 0));
+        unsigned int k = 0;
+        for (CardT c : col) {
+            m_cards[(x * Depth + k++) * m_boards + b] = c.code();
+        }
+        m_sizes[x * m_boards + b] = static_cast<unsigned char>(k);
+        m_tops[x * m_boards + b] = col.isEmpty() ? 0 : col.peek().code();
+    }
+    m_heights[b] = g.foundationHeights();
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::fill(const GameType & g) {
+    for (unsigned int b = 0; b < m_boards; b++) {
+        load(b, g);
+    }
+}
+
+
+template <class V>
+typename BasicBatchGameT<V>::GameType BasicBatchGameT<V>::board(unsigned int b) const {
+    checkBoard(b);
+    std::array<ColumnT, Columns> cols;
+    for (unsigned int x = 0; x < Columns; x++) {
+        switch (GameType::placement(x)) {
+            case Cascade:
+                cols[x] = ColumnT(GameType::CascadeCapacity);
+                break;
+            case Cell:
+                cols[x] = ColumnT(1);
+                break;
+            case Foundation:
+                cols[x] = ColumnT(13);
+                break;
+        }
+        for (unsigned int k = 0; k < m_sizes[x * m_boards + b]; k++) {
+            cols[x].push(CardT(m_cards[(x * Depth + k) * m_boards + b]));
+        }
+    }
+
+    return GameType(cols);
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::hasWon(std::vector<unsigned char> & won) const {
+    // The board count is read once: the stores below could otherwise alias
+    // it, which would stop the loop from vectorizing.
+    unsigned int boards = m_boards;
+    won.resize(boards);
+    const FoundationHeightsT * heights = m_heights.data();
+    unsigned char * out = won.data();
+    for (unsigned int b = 0; b < boards; b++) {
+        out[b] = heightsComplete(heights[b]);
+    }
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::foundationHeights(std::vector<FoundationHeightsT> & heights) const {
+    heights.assign(m_heights.begin(), m_heights.end());
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::homeCounts(std::vector<unsigned char> & counts) const {
+    unsigned int boards = m_boards;
+    counts.resize(boards);
+    const FoundationHeightsT * heights = m_heights.data();
+    unsigned char * out = counts.data();
+    for (unsigned int b = 0; b < boards; b++) {
+        out[b] = static_cast<unsigned char>(heightsTotal(heights[b]));
+    }
+}
+
+
+// The rules of GameT on the top cards of one board, with 0 for an empty
+// column, returning 1 if the card `c` may go on the top card `t`. The codes
+// are widened to 32 bits and combined with & and | rather than branches, so
+// that the loops applying them to every board vectorize.
+
+static inline uint32_t laneBuild(uint32_t c, uint32_t t) {
+    return ((t == 0) & ((c & CARD_RANK_MASK) == Ace)) | ((t != 0) & (t + 1 == c));
+}
+
+
+template <class V>
+static inline uint32_t laneStack(uint32_t c, uint32_t t) {
+    uint32_t empty = (t == 0) & (!V::KingsOnly || (c & CARD_RANK_MASK) == King);
+    if (V::SameSuit) {
+        return empty | ((t != 0) & (t == c + 1));
+    }
+
+    return empty | (
+        (t != 0) &
+        (((t ^ c) & CARD_RED_BIT) != 0) &
+        ((t & CARD_RANK_MASK) == (c & CARD_RANK_MASK) + 1)
+    );
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::moveMasks(std::vector<uint32_t> & masks) const {
+    unsigned int boards = m_boards;
+    masks.assign(Columns * boards, 0);
+    for (unsigned int s = 0; s < Columns; s++) {
+        const CardCodeT * src = m_tops.data() + s * boards;
+        uint32_t * out = masks.data() + s * boards;
+        for (unsigned int d = 0; d < Columns; d++) {
+            const CardCodeT * dst = m_tops.data() + d * boards;
+            switch (GameType::placement(d)) {
+                case Cell:
+                    for (unsigned int b = 0; b < boards; b++) {
+                        out[b] |= static_cast<uint32_t>((src[b] != 0) & (dst[b] == 0)) << d;
+                    }
+                    break;
+                case Foundation:
+                    if (GameType::placement(s) == Foundation) {
+                        break;
+                    }
+                    for (unsigned int b = 0; b < boards; b++) {
+                        out[b] |= ((src[b] != 0) & laneBuild(src[b], dst[b])) << d;
+                    }
+                    break;
+                case Cascade:
+                    for (unsigned int b = 0; b < boards; b++) {
+                        out[b] |= ((src[b] != 0) & laneStack<V>(src[b], dst[b])) << d;
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+
+template <class V>
+void BasicBatchGameT<V>::applyMoves(const std::vector<MoveT> & moves) {
+    if (moves.size() != m_boards) {
+        throw invalid_move();
+    }
+
+    for (unsigned int b = 0; b < m_boards; b++) {
+        MoveT m = moves[b];
+        unsigned int n = m.count();
+        if (n == 0) {
+            continue;
+        }
+
+        unsigned int s = m.src();
+        unsigned int d = m.dst();
+        unsigned int sn = m_sizes[s * m_boards + b] - n;
+        unsigned int dn = m_sizes[d * m_boards + b];
+
+        // Only single cards move to or from the foundations, each changing
+        // the height of its suit by one.
+        FoundationHeightsT suit = static_cast<FoundationHeightsT>(1) <<
+            (8 * codeSuit(m_cards[(s * Depth + sn) * m_boards + b]));
+        if (GameType::placement(d) == Foundation) {
+            m_heights[b] += suit;
+        }
+        if (GameType::placement(s) == Foundation) {
+            m_heights[b] -= suit;
+        }
+
+        for (unsigned int k = 0; k < n; k++) {
+            m_cards[(d * Depth + dn + k) * m_boards + b] = m_cards[(s * Depth + sn + k) * m_boards + b];
+        }
+        dn += n;
+
+        m_sizes[s * m_boards + b] = static_cast<unsigned char>(sn);
+        m_sizes[d * m_boards + b] = static_cast<unsigned char>(dn);
+        m_tops[s * m_boards + b] = sn == 0 ? 0 : m_cards[(s * Depth + sn - 1) * m_boards + b];
+        m_tops[d * m_boards + b] = m_cards[(d * Depth + dn - 1) * m_boards + b];
+    }
+}
+
+
+template class BasicBatchGameT<FreeCell>;
+template class BasicBatchGameT<BakersGame>;
+template class BasicBatchGameT<EightOff>;
+template class BasicBatchGameT<Seahaven>;
+template class BasicBatchGameT<TwoCellFreeCell>;
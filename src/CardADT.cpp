@@ -5,22 +5,31 @@
 #include "CardADT.h"
 
 
+CardT::CardT() :
+    m_c(0)
+{}
+
+
 CardT::CardT(SuitT S, RankT R) :
-    m_s(S),
-    m_r(R)
+    m_c(packCard(S, R))
+{}
+
+
+CardT::CardT(CardCodeT c) :
+    m_c(c)
 {}
 
 
 SuitT CardT::suit() const {
-    return m_s;
+    return codeSuit(m_c);
 }
 
 
 RankT CardT::rank() const {
-    return m_r;
+    return codeRank(m_c);
 }
 
 
 bool CardT::isRed() const {
-    return m_s == Hearts || m_s == Diamonds;
+    return codeIsRed(m_c);
 }
@@ -0,0 +1,145 @@
+/**
+ * \file DealADT.cpp
+ * \author agent <agent@local>
+ */
+#include "DealADT.h"
+#include "Exceptions.h"
+#include "Zobrist.h"
+
+
+DeckT microsoftDeck(uint32_t n) {
+    // Microsoft numbers the cards rank-major with suits in the order clubs,
+    // diamonds, hearts, spades.
+    static const SuitT suits[4] = { Clubs, Diamonds, Hearts, Spades };
+    CardCodeT deck[52];
+    for (int i = 0; i < 52; i++) {
+        deck[i] = packCard(suits[i % 4], i / 4 + 1);
+    }
+
+    // The Microsoft C runtime rand().
+    uint32_t state = n;
+    DeckT out;
+    for (int k = 0, left = 52; k < 52; k++) {
+        state = state * 214013 + 2531011;
+        int j = ((state >> 16) & 0x7fff) % left;
+        out[k] = deck[j];
+        deck[j] = deck[--left];
+    }
+
+    return out;
+}
+
+
+// Returns N / 52 ordered decks shuffled together by splitmix64.
+template <std::size_t N>
+static std::array<CardCodeT, N> fastShuffle(uint64_t seed) {
+    std::array<CardCodeT, N> out;
+    for (int i = 0; i < static_cast<int>(N); i++) {
+        out[i] = packCard(static_cast<SuitT>(i % 52 / 13), i % 13 + 1);
+    }
+
+    for (int i = N - 1; i > 0; i--) {
+        seed += 0x9e3779b97f4a7c15ULL;
+        // Maps the top 32 bits into [0,i] without a division.
+        uint64_t j = ((zobristMix(seed) >> 32) * static_cast<uint64_t>(i + 1)) >> 32;
+        CardCodeT c = out[i];
+        out[i] = out[j];
+        out[j] = c;
+    }
+
+    return out;
+}
+
+
+DeckT fastDeck(uint64_t seed) {
+    return fastShuffle<52>(seed);
+}
+
+
+DoubleDeckT fastDoubleDeck(uint64_t seed) {
+    return fastShuffle<104>(seed);
+}
+
+
+// Number of decks shuffled together by DealArenaT::dealFast.
+static const int LANES = 8;
+
+
+DealArenaT::DealArenaT(unsigned long capacity) :
+    m_decks(capacity),
+    m_seeds(capacity),
+    m_size(0)
+{}
+
+
+void DealArenaT::dealFast(uint64_t first, unsigned long n) {
+    if (n > capacity()) {
+        throw full();
+    }
+
+    DeckT ordered;
+    for (int i = 0; i < 52; i++) {
+        ordered[i] = packCard(static_cast<SuitT>(i / 13), i % 13 + 1);
+    }
+
+    for (unsigned long b = 0; b < n; b += LANES) {
+        int lanes = n - b < LANES ? n - b : LANES;
+        uint64_t state[LANES];
+        uint64_t pick[LANES];
+        for (int l = 0; l < LANES; l++) {
+            state[l] = first + b + l;
+        }
+        for (int l = 0; l < lanes; l++) {
+            m_seeds[b + l] = first + b + l;
+            m_decks[b + l] = ordered;
+        }
+
+        // The same sequence as fastDeck, one lane per deck.
+        for (int i = 51; i > 0; i--) {
+            for (int l = 0; l < LANES; l++) {
+                state[l] += 0x9e3779b97f4a7c15ULL;
+                pick[l] = ((zobristMix(state[l]) >> 32) * static_cast<uint64_t>(i + 1)) >> 32;
+            }
+            for (int l = 0; l < lanes; l++) {
+                DeckT &d = m_decks[b + l];
+                CardCodeT c = d[i];
+                d[i] = d[pick[l]];
+                d[pick[l]] = c;
+            }
+        }
+    }
+    m_size = n;
+}
+
+
+void DealArenaT::dealMicrosoft(uint32_t first, unsigned long n) {
+    if (n > capacity()) {
+        throw full();
+    }
+
+    for (unsigned long k = 0; k < n; k++) {
+        m_seeds[k] = first + k;
+        m_decks[k] = microsoftDeck(first + k);
+    }
+    m_size = n;
+}
+
+
+unsigned long DealArenaT::size() const {
+    return m_size;
+}
+
+
+unsigned long DealArenaT::capacity() const {
+    return m_decks.size();
+}
+
+
+const DeckT & DealArenaT::deck(unsigned long k) const {
+    return m_decks[k];
+}
+
+
+uint64_t DealArenaT::seed(unsigned long k) const {
+    return m_seeds[k];
+}
@@ -0,0 +1,368 @@
+/**
+ * \file FortyThievesADT.cpp
+ * \author agent <agent@local>
+ */
+#include "Exceptions.h"
+#include "FortyThievesADT.h"
+#include "Zobrist.h"
+
+
+// Keys for the parts of the board hashed other than by pile. The waste is
+// deeper than zobristKey reaches, so its keys are mixed from the depth.
+
+static uint64_t wasteKey(CardCodeT c, unsigned int depth) {
+    return zobristMix(zobristSalt(FortyWaste) ^ (static_cast<uint64_t>(depth) << 8) ^ c);
+}
+
+
+static uint64_t foundationKey(unsigned int f, unsigned int h) {
+    return zobristMix(zobristSalt(FortyFoundation + f) ^ h);
+}
+
+
+// The stock is only ever dealt from, so its size determines it.
+static uint64_t stockKey(unsigned int n) {
+    return zobristMix(zobristSalt(FortyStock) ^ n);
+}
+
+
+FortyThievesT::FortyThievesT(uint64_t seed) :
+    FortyThievesT(fastDoubleDeck(seed))
+{}
+
+
+FortyThievesT::FortyThievesT(const DoubleDeckT & deck) :
+    m_waste(64),
+    m_stock(64),
+    m_hash(stockKey(0))
+{
+    for (unsigned int f = 0; f < 8; f++) {
+        m_foundations[f] = 0;
+        m_hash ^= foundationKey(f, 0);
+    }
+    for (unsigned int i = 0; i < 10; i++) {
+        m_piles[i] = PileT(16);
+        m_pileHash[i] = 0;
+        m_hash ^= zobristMix(zobristSalt(i));
+    }
+    for (unsigned int k = 0; k < 40; k++) {
+        pushPile(k % 10, CardT(deck[k]));
+    }
+    for (unsigned int k = 40; k < 104; k++) {
+        m_stock.push(CardT(deck[k]));
+    }
+    m_hash ^= stockKey(0) ^ stockKey(m_stock.size());
+}
+
+
+const PileT & FortyThievesT::pile(unsigned int i) const {
+    if (i > 9) {
+        throw invalid_placement();
+    }
+
+    return m_piles[i];
+}
+
+
+const StockT & FortyThievesT::waste() const {
+    return m_waste;
+}
+
+
+const StockT & FortyThievesT::stock() const {
+    return m_stock;
+}
+
+
+unsigned int FortyThievesT::foundationHeight(unsigned int f) const {
+    if (f > 7) {
+        throw invalid_placement();
+    }
+
+    return m_foundations[f];
+}
+
+
+bool FortyThievesT::hasWon() const {
+    for (unsigned char h : m_foundations) {
+        if (h != King) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool FortyThievesT::noValidMoves() const {
+    if (!m_stock.isEmpty()) {
+        return false;
+    }
+
+    for (unsigned int s = 0; s <= FortyWaste; s++) {
+        for (unsigned int d = 0; d < 16; d++) {
+            if (d != FortyWaste && d != FortyStock && checkMove(MoveT(s, d)) == MoveOk) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+CardT FortyThievesT::top(unsigned int s) const {
+    return s == FortyWaste ? m_waste.peek() : m_piles[s].peek();
+}
+
+
+MoveStatusT FortyThievesT::checkMove(MoveT m) const {
+    unsigned int s = m.src();
+    unsigned int d = m.dst();
+    if (s == FortyStock) {
+        if (d != FortyWaste) {
+            return MoveInvalidPlacement;
+        }
+        if (m_stock.isEmpty()) {
+            return MoveEmptySource;
+        }
+        return m.count() == 1 ? MoveOk : MoveInvalid;
+    }
+
+    if (s > FortyWaste || d == FortyWaste || d == FortyStock || d > FortyFoundation + 3) {
+        return MoveInvalidPlacement;
+    }
+
+    if (s == FortyWaste ? m_waste.isEmpty() : m_piles[s].isEmpty()) {
+        return MoveEmptySource;
+    }
+
+    if (m.count() != 1 || s == d) {
+        return MoveInvalid;
+    }
+
+    CardT c = top(s);
+    if (d >= FortyFoundation) {
+        unsigned int f = 2 * (d - FortyFoundation);
+        if (c.suit() != static_cast<SuitT>(d - FortyFoundation) ||
+                (m_foundations[f] != c.rank() - 1 && m_foundations[f + 1] != c.rank() - 1)) {
+            return MoveInvalid;
+        }
+        return MoveOk;
+    }
+
+    const PileT &dst = m_piles[d];
+    return canStack<FortyThieves>(c.code(), dst.isEmpty(), dst.isEmpty() ? 0 : dst.peek().code()) ?
+        MoveOk : MoveInvalid;
+}
+
+
+MoveStatusT FortyThievesT::tryMove(MoveT m) {
+    MoveStatusT status = checkMove(m);
+    if (status == MoveOk) {
+        applyTrusted(m);
+    }
+
+    return status;
+}
+
+
+void FortyThievesT::performMove(MoveT m) {
+    throwMoveStatus(tryMove(m));
+}
+
+
+void FortyThievesT::applyTrusted(MoveT m) {
+    unsigned int s = m.src();
+    unsigned int d = m.dst();
+
+    JournalEntryT e;
+    e.src = static_cast<unsigned char>(s);
+    e.dst = static_cast<unsigned char>(d);
+    e.card = (s == FortyStock ? m_stock.peek() : top(s)).code();
+    e.count = 1;
+    e.automatic = false;
+    m_journal.record(e);
+
+    transfer(s, d);
+}
+
+
+void FortyThievesT::togglePile(unsigned int x, CardCodeT c, unsigned int depth) {
+    uint64_t h = m_pileHash[x] ^ zobristKey(c, depth);
+    m_hash ^= zobristMix(m_pileHash[x] ^ zobristSalt(x)) ^ zobristMix(h ^ zobristSalt(x));
+    m_pileHash[x] = h;
+}
+
+
+void FortyThievesT::pushPile(unsigned int x, CardT c) {
+    togglePile(x, c.code(), m_piles[x].size());
+    m_piles[x].push(c);
+}
+
+
+void FortyThievesT::popPile(unsigned int x) {
+    CardCodeT c = m_piles[x].peek().code();
+    m_piles[x].pop();
+    togglePile(x, c, m_piles[x].size());
+}
+
+
+void FortyThievesT::pushWaste(CardT c) {
+    m_hash ^= wasteKey(c.code(), m_waste.size());
+    m_waste.push(c);
+}
+
+
+void FortyThievesT::popWaste() {
+    CardCodeT c = m_waste.peek().code();
+    m_waste.pop();
+    m_hash ^= wasteKey(c, m_waste.size());
+}
+
+
+void FortyThievesT::setFoundation(unsigned int f, unsigned int h) {
+    m_hash ^= foundationKey(f, m_foundations[f]) ^ foundationKey(f, h);
+    m_foundations[f] = static_cast<unsigned char>(h);
+}
+
+
+void FortyThievesT::transfer(unsigned int s, unsigned int d) {
+    if (s == FortyStock) {
+        m_hash ^= stockKey(m_stock.size()) ^ stockKey(m_stock.size() - 1);
+        pushWaste(m_stock.peek());
+        m_stock.pop();
+        return;
+    }
+
+    CardT c = top(s);
+    if (s == FortyWaste) {
+        popWaste();
+    } else {
+        popPile(s);
+    }
+
+    if (d >= FortyFoundation) {
+        // The taller foundation of the suit takes the card if it can, which
+        // keeps it the taller.
+        unsigned int f = 2 * (d - FortyFoundation);
+        if (m_foundations[f] != c.rank() - 1) {
+            f++;
+        }
+        setFoundation(f, c.rank());
+    } else {
+        pushPile(d, c);
+    }
+}
+
+
+void FortyThievesT::untransfer(unsigned int s, unsigned int d, CardCodeT card) {
+    if (s == FortyStock) {
+        m_hash ^= stockKey(m_stock.size()) ^ stockKey(m_stock.size() + 1);
+        m_stock.push(m_waste.peek());
+        popWaste();
+        return;
+    }
+
+    if (d >= FortyFoundation) {
+        // The inverse of transfer's choice: the shorter foundation gave the
+        // card if it is the one at its rank.
+        unsigned int f = 2 * (d - FortyFoundation) + 1;
+        if (m_foundations[f] != codeRank(card)) {
+            f--;
+        }
+        setFoundation(f, codeRank(card) - 1);
+    } else {
+        popPile(d);
+    }
+
+    if (s == FortyWaste) {
+        pushWaste(CardT(card));
+    } else {
+        pushPile(s, CardT(card));
+    }
+}
+
+
+void FortyThievesT::generateMoves(MoveBuffer & moves) const {
+    bool empty[11];
+    CardCodeT tops[11];
+    for (unsigned int c = 0; c <= FortyWaste; c++) {
+        empty[c] = c == FortyWaste ? m_waste.isEmpty() : m_piles[c].isEmpty();
+        tops[c] = empty[c] ? 0 : top(c).code();
+    }
+
+    moves.clear();
+    for (unsigned int s = 0; s <= FortyWaste; s++) {
+        if (empty[s]) {
+            continue;
+        }
+
+        SuitT suit = codeSuit(tops[s]);
+        RankT below = codeRank(tops[s]) - 1;
+        if (m_foundations[2 * suit] == below || m_foundations[2 * suit + 1] == below) {
+            moves.push(MoveT(s, FortyFoundation + suit));
+        }
+    }
+
+    for (unsigned int s = 0; s <= FortyWaste; s++) {
+        if (empty[s]) {
+            continue;
+        }
+
+        uint32_t dsts = 0;
+        for (unsigned int d = 0; d < 10; d++) {
+            if (d != s && canStack<FortyThieves>(tops[s], empty[d], tops[d])) {
+                dsts |= static_cast<uint32_t>(1) << d;
+            }
+        }
+        moves.pushAll(s, dsts);
+    }
+
+    if (!m_stock.isEmpty()) {
+        moves.push(MoveT(FortyStock, FortyWaste));
+    }
+}
+
+
+void FortyThievesT::setJournaling(bool on) {
+    m_journal.setEnabled(on);
+}
+
+
+bool FortyThievesT::isJournaling() const {
+    return m_journal.isEnabled();
+}
+
+
+void FortyThievesT::undoMove() {
+    unsigned int n = m_journal.undo();
+    for (unsigned int k = m_journal.applied() + n; k-- > m_journal.applied(); ) {
+        const JournalEntryT &e = m_journal[k];
+        untransfer(e.src, e.dst, e.card);
+    }
+}
+
+
+void FortyThievesT::redoMove() {
+    unsigned int n = m_journal.redo();
+    for (unsigned int k = m_journal.applied() - n; k < m_journal.applied(); k++) {
+        const JournalEntryT &e = m_journal[k];
+        transfer(e.src, e.dst);
+    }
+}
+
+
+unsigned int FortyThievesT::undoCount() const {
+    return m_journal.undoCount();
+}
+
+
+unsigned int FortyThievesT::redoCount() const {
+    return m_journal.redoCount();
+}
+
+
+uint64_t FortyThievesT::hash() const {
+    return m_hash;
+}
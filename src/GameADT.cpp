@@ -2,196 +2,967 @@
  * \file GameADT.cpp
  * \author Emily Horsman <horsmane@mcmaster.ca>
  * \brief Provides an ADT representing a model for the game of FreeCell
- *   including board state and its transitions.
+ *   and its variants including board state and its transitions.
  */
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <random>
 #include <tuple>
 #include <vector>
 
 #include "Exceptions.h"
 #include "GameADT.h"
 #include "GameTypes.h"
+#include "StatsADT.h"
+#include "Zobrist.h"
+
+
+template <class V>
+BasicGameT<V>::BasicGameT() :
+    m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    std::random_device rd;
+    deal(fastDeck((static_cast<uint64_t>(rd()) << 32) | rd()));
+}
+
+
+template <class V>
+BasicGameT<V>::BasicGameT(uint64_t seed, DealT mode) :
+    m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    if (mode == MicrosoftDeal) {
+        deal(microsoftDeck(static_cast<uint32_t>(seed)));
+    } else {
+        deal(fastDeck(seed));
+    }
+}
+
+
+template <class V>
+BasicGameT<V>::BasicGameT(const DeckT & deck) :
+    m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    deal(deck);
+}
+
+
+template <class V>
+BasicGameT<V>::BasicGameT(const SnapshotViewT & s) :
+    m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    if (Columns > 16) {
+        throw invalid_board();
+    }
+
+    makeColumns();
+    unsigned int total = 0;
+    for (unsigned int x = 0; x < 16; x++) {
+        unsigned int capacity = x < Columns ? m_cols[x].capacity() : 0;
+        if (s.length(x) > capacity) {
+            throw invalid_board();
+        }
+        total += s.length(x);
+    }
+    if (total != 52) {
+        throw invalid_board();
+    }
+
+    // Check the cards as BoardParserT::game does before any of them indexes
+    // a table: each must have a valid rank and suit and appear once.
+    const unsigned char * card = s.data() + 16;
+    CardMaskT seen = 0;
+    for (unsigned int k = 0; k < 52; k++) {
+        CardCodeT c = card[k];
+        if (c >= 64 || codeRank(c) < Ace || codeRank(c) > King || (seen & cardBit(c))) {
+            throw invalid_board();
+        }
+        seen |= cardBit(c);
+    }
+
+    for (unsigned int x = 0; x < Columns; x++) {
+        for (unsigned int k = 0; k < s.length(x); k++) {
+            m_cols[x].push(CardT(*card++));
+        }
+    }
+    rehash();
+    remask();
+}
+
+
+template <class V>
+SnapshotT BasicGameT<V>::snapshot() const {
+    STAT_CALL(StatGameSnapshot);
+    unsigned int total = 0;
+    for (const ColumnT &col : m_cols) {
+        total += col.size();
+    }
+    if (total != 52 || Columns > 16) {
+        throw invalid_board();
+    }
+
+    SnapshotT s;
+    s.fill(0);
+    unsigned int offset = 16;
+    for (unsigned int x = 0; x < Columns; x++) {
+        s[x] = static_cast<unsigned char>(m_cols[x].size());
+        for (CardT c : m_cols[x]) {
+            s[offset++] = c.code();
+        }
+    }
+
+    return s;
+}
+
+
+template <class V>
+void BasicGameT<V>::deal(const DeckT & deck) {
+    makeColumns();
+    const unsigned int cascaded = 52 - V::DealtToCells;
+    for (unsigned int i = 0; i < cascaded; i++) {
+        m_cols[i % Cascades].push(CardT(deck[i]));
+    }
+    for (unsigned int i = cascaded; i < 52; i++) {
+        m_cols[Cascades + i - cascaded].push(CardT(deck[i]));
+    }
+    rehash();
+    remask();
+}
 
 
-GameT::GameT() {
-    for (int i = 0; i < 8; i++) {
-        // Cascades only require a capacity of 19, because they be dealt with
-        // up to 7 cards on them, and if the last card is a King then 12 more
-        // cards could be stacked on top.
-        m_cols[i] = Stack<CardT>(19);
+template <class V>
+void BasicGameT<V>::makeColumns() {
+    for (unsigned int i = 0; i < Cascades; i++) {
+        // In FreeCell cascades only require a capacity of 19, because they be
+        // dealt with up to 7 cards on them, and if the last card is a King
+        // then 12 more cards could be stacked on top.
+        m_cols[i] = ColumnT(CascadeCapacity);
     }
-    for (int i = 8; i < 12; i++) {
+    for (unsigned int i = Cascades; i < Cascades + Cells; i++) {
         // Instead of handling cells particularly, just make them bounded
         // stacks of capacity 1.
-        m_cols[i] = Stack<CardT>(1);
+        m_cols[i] = ColumnT(1);
     }
-    for (int i = 12; i < 16; i++) {
-        m_cols[i] = Stack<CardT>(13);
+    for (unsigned int i = Cascades + Cells; i < Columns; i++) {
+        m_cols[i] = ColumnT(13);
     }
+}
 
-    std::vector<CardT> deck;
-    for (int i = 0; i < 52; i++) {
-        deck.push_back(CardT(static_cast<SuitT>(i / 13), i % 13));
-    }
-    std::random_shuffle(deck.begin(), deck.end());
-    for (int i = 0; i < 52; i++) {
-        m_cols[i % 8].push(deck[i]);
+
+template <class V>
+BasicGameT<V>::BasicGameT(std::array<Stack<CardT>, Columns> cols) :
+    m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    for (unsigned int i = 0; i < Columns; i++) {
+        if (cols[i].size() > ColumnBound) {
+            throw invalid_board();
+        }
+        int capacity = std::min(cols[i].capacity(), ColumnBound);
+        m_cols[i] = capacity > 0 ? ColumnT(capacity) : ColumnT();
+        for (CardT c : cols[i].seq()) {
+            m_cols[i].push(c);
+        }
     }
+    rehash();
+    remask();
+}
+
+
+template <class V>
+BasicGameT<V>::BasicGameT(const std::array<ColumnT, Columns> & cols)
+    : m_cols(cols),
+      m_autoplay(false),
+    m_stale(false)
+{
+    STAT_CALL(StatGameConstruct);
+    rehash();
+    remask();
 }
 
 
-GameT::GameT(std::array<Stack<CardT>, 16> cols)
-    : m_cols(cols)
-{}
+template <class V>
+BasicGameT<V>::BasicGameT(const BasicGameT & g)
+    : m_cols(g.m_cols),
+      m_autoplay(g.m_autoplay),
+      m_colHash(g.m_colHash),
+      m_hash(g.m_hash),
+      m_canonicalHash(g.m_canonicalHash),
+      m_tops(g.m_tops),
+      m_cells(g.m_cells),
+      m_next(g.m_next),
+      m_heights(g.m_heights),
+      m_where(g.m_where),
+      m_stale(g.m_stale)
+{
+    STAT_CALL(StatGameCopyConstruct);
+    // Copied in the body so that its allocation is counted.
+    m_journal = g.m_journal;
+}
+
 
+template <class V>
+BasicGameT<V> & BasicGameT<V>::operator=(const BasicGameT & g) {
+    STAT_CALL(StatGameCopyAssign);
+    m_cols = g.m_cols;
+    m_journal = g.m_journal;
+    m_autoplay = g.m_autoplay;
+    m_colHash = g.m_colHash;
+    m_hash = g.m_hash;
+    m_canonicalHash = g.m_canonicalHash;
+    m_tops = g.m_tops;
+    m_cells = g.m_cells;
+    m_next = g.m_next;
+    m_heights = g.m_heights;
+    m_where = g.m_where;
+    m_stale = g.m_stale;
+    return *this;
+}
 
-bool GameT::isValidPlacement(PlacementT p, unsigned int i) const {
+
+template <class V>
+bool BasicGameT<V>::isValidPlacement(PlacementT p, unsigned int i) const {
     if (p == Cascade) {
-        return i <= 7;
+        return i < Cascades;
     }
-    return i <= 3;
+    return i < (p == Cell ? Cells : Foundations);
 }
 
 
-bool GameT::isValidBuild(CardT c, unsigned int j) {
-    auto s = getCol(Foundation, j);
-    if (s.isEmpty()) {
-        return c.rank() == 1;
+template <class V>
+bool BasicGameT<V>::isValidBuild(CardT c, unsigned int j) const {
+    if (!(cardBit(c.code()) & m_next)) {
+        return false;
     }
 
-    return (
-        s.peek().suit() == c.suit() &&
-        s.peek().rank() == c.rank() - 1
-    );
+    // The card its suit needs next goes on the foundation holding the card
+    // below it, or on any empty one if it is an Ace.
+    unsigned int d = column(Foundation, j);
+    return c.rank() == Ace ? m_cols[d].isEmpty() : m_where[c.code() - 1] == d;
 }
 
 
-bool GameT::isValidStack(CardT c, unsigned int j) {
-    auto s = getCol(Cascade, j);
+template <class V>
+bool BasicGameT<V>::isValidStack(CardT c, unsigned int j) const {
+    const ColumnT &s = m_cols[j];
     if (s.isEmpty()) {
-        return true;
+        return canStack<V>(c.code(), true, 0);
     }
 
-    return (
-        s.peek().isRed() != c.isRed() &&
-        s.peek().rank() - 1 == c.rank()
-    );
+    return (stackTargets(c) & cardBit(s.peek().code())) != 0;
 }
 
 
-bool GameT::hasWon() const {
-    for (int i = 12; i <= 15; i++) {
-        if (m_cols[i].isEmpty()) {
-            return false;
-        }
-
-        if (m_cols[i].peek().rank() != King) {
-            return false;
-        }
+template <class V>
+bool BasicGameT<V>::isLegal(unsigned int s, unsigned int d) const {
+    switch (placement(d)) {
+        case Cell:
+            return m_cols[d].isEmpty();
+        case Foundation:
+            return placement(s) != Foundation && isValidBuild(m_cols[s].peek(), d - column(Foundation, 0));
+        case Cascade:
+            return isValidStack(m_cols[s].peek(), d);
     }
 
     return true;
 }
 
 
-bool GameT::isValidMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) {
-    bool isValid = isValidPlacement(p, i) && isValidPlacement(q, j);
-    if (!isValid) {
+// Number of cards at the top of a column which form a run, each stacked
+// validly on the card below it.
+template <class V>
+static unsigned int topRun(const ColumnT & col) {
+    const CardT * c = col.end();
+    if (c == col.begin()) {
+        return 0;
+    }
+
+    unsigned int n = 1;
+    for (--c; c != col.begin() && canStack<V>(c->code(), false, c[-1].code()); --c) {
+        n++;
+    }
+    return n;
+}
+
+
+template <class V>
+bool BasicGameT<V>::isLegalRun(unsigned int s, unsigned int d, unsigned int n) const {
+    if (placement(s) != Cascade || placement(d) != Cascade || s == d) {
+        return false;
+    }
+
+    const ColumnT &src = m_cols[s];
+    const ColumnT &dst = m_cols[d];
+    if (n > topRun<V>(src) || n > supermoveCapacity(dst.isEmpty())) {
+        return false;
+    }
+
+    return canStack<V>(src.end()[-static_cast<int>(n)].code(), dst.isEmpty(),
+                    dst.isEmpty() ? 0 : dst.peek().code());
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::runLength(unsigned int i) const {
+    if (!isValidPlacement(Cascade, i)) {
         throw invalid_placement();
     }
 
-    Stack<CardT> src = getCol(p, i);
-    Stack<CardT> dst = getCol(q, j);
-    if (src.isEmpty()) {
-        throw empty_source();
+    return topRun<V>(m_cols[i]);
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::supermoveCapacity(bool toEmptyCascade) const {
+    unsigned int cells = 0;
+    for (unsigned int x = Cascades; x < Cascades + Cells; x++) {
+        cells += m_cols[x].isEmpty();
+    }
+    if (V::KingsOnly) {
+        return cells + 1;
     }
 
-    switch (q) {
-        case Cell:
-            return dst.isEmpty();
-        case Foundation:
-            if (p == Foundation) {
-                return false;
-            }
-            return isValidBuild(src.peek(), j);
-        case Cascade:
-            return isValidStack(src.peek(), j);
+    unsigned int cascades = 0;
+    for (unsigned int x = 0; x < Cascades; x++) {
+        cascades += m_cols[x].isEmpty();
+    }
+    if (toEmptyCascade && cascades > 0) {
+        cascades--;
+    }
+
+    return (cells + 1) << cascades;
+}
+
+
+template <class V>
+bool BasicGameT<V>::hasWon() const {
+    sync();
+    return heightsComplete(m_heights);
+}
+
+
+template <class V>
+FoundationHeightsT BasicGameT<V>::foundationHeights() const {
+    sync();
+    return m_heights;
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::homeCount() const {
+    sync();
+    return heightsTotal(m_heights);
+}
+
+
+template <class V>
+MoveStatusT BasicGameT<V>::checkMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) const {
+    STAT_CALL(StatGameCheckMove);
+    sync();
+    if (!isValidPlacement(p, i) || !isValidPlacement(q, j)) {
+        return MoveInvalidPlacement;
+    }
+
+    unsigned int s = column(p, i);
+    if (m_cols[s].isEmpty()) {
+        return MoveEmptySource;
+    }
+
+    return isLegal(s, column(q, j)) ? MoveOk : MoveInvalid;
+}
+
+
+template <class V>
+MoveStatusT BasicGameT<V>::tryMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) {
+    STAT_CALL(StatGameTryMove);
+    MoveStatusT status = checkMove(p, i, q, j);
+    if (status == MoveOk) {
+        applyMove(column(p, i), column(q, j));
+    }
+
+    return status;
+}
+
+
+template <class V>
+MoveStatusT BasicGameT<V>::checkMove(MoveT m) const {
+    STAT_CALL(StatGameCheckMove);
+    sync();
+    if (m.src() >= Columns || m.dst() >= Columns) {
+        return MoveInvalidPlacement;
+    }
+
+    if (m_cols[m.src()].isEmpty()) {
+        return MoveEmptySource;
+    }
+
+    if (m.count() == 1) {
+        return isLegal(m.src(), m.dst()) ? MoveOk : MoveInvalid;
+    }
+    return m.count() > 1 && isLegalRun(m.src(), m.dst(), m.count()) ? MoveOk : MoveInvalid;
+}
+
+
+template <class V>
+MoveStatusT BasicGameT<V>::tryMove(MoveT m) {
+    STAT_CALL(StatGameTryMove);
+    MoveStatusT status = checkMove(m);
+    if (status == MoveOk) {
+        applyMove(m.src(), m.dst(), m.count());
+    }
+
+    return status;
+}
+
+
+template <class V>
+void BasicGameT<V>::applyTrusted(MoveT m) {
+    STAT_CALL(StatGameApplyTrusted);
+    applyMove(m.src(), m.dst(), m.count());
+}
+
+
+template <class V>
+bool BasicGameT<V>::isValidMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) const {
+    STAT_CALL(StatGameIsValidMove);
+    switch (checkMove(p, i, q, j)) {
+        case MoveInvalidPlacement:
+            throw invalid_placement();
+        case MoveEmptySource:
+            throw empty_source();
+        case MoveInvalid:
+            return false;
+        case MoveOk:
+            break;
     }
 
     return true;
 }
 
 
-std::vector<std::tuple<PlacementT, unsigned int>> GameT::getAllPositions() const {
-    std::vector<std::tuple<PlacementT, unsigned int>> moves;
-    for (PlacementT p : { Cascade, Cell, Foundation }) {
-        for (int j = p == Cascade ? 7 : 3; j >= 0; j--) {
-            moves.push_back(std::make_tuple(p, j));
+template <class V>
+bool BasicGameT<V>::noValidMoves() const {
+    STAT_CALL(StatGameNoValidMoves);
+    sync();
+    for (unsigned int s = 0; s < Columns; s++) {
+        if (m_cols[s].isEmpty()) {
+            continue;
+        }
+
+        for (unsigned int d = 0; d < Columns; d++) {
+            if (d != s && isLegal(s, d)) {
+                return false;
+            }
         }
     }
 
-    return moves;
+    return true;
 }
 
 
-bool GameT::noValidMoves() {
-    std::vector<std::tuple<PlacementT, unsigned int>> positions = getAllPositions();
-    PlacementT p, q;
-    unsigned int i, j;
-    for (auto a : positions) {
-        std::tie(p, i) = a;
-        if (getCol(p, i).isEmpty()) {
+template <class V>
+void BasicGameT<V>::generateMoves(MoveBufferT & moves, bool supermoves) const {
+    STAT_CALL(StatGameGenerateMoves);
+    sync();
+    bool empty[Columns];
+    CardCodeT top[Columns];
+    for (unsigned int c = 0; c < Columns; c++) {
+        empty[c] = m_cols[c].isEmpty();
+        top[c] = empty[c] ? 0 : m_cols[c].peek().code();
+    }
+
+    // The empty columns of each kind as sets of board columns.
+    uint32_t none = 0;
+    for (unsigned int c = 0; c < Columns; c++) {
+        none |= static_cast<uint32_t>(empty[c]) << c;
+    }
+    uint32_t noneCascades = none & ((1u << Cascades) - 1);
+    uint32_t noneCells = none & (((1u << Cells) - 1) << Cascades);
+    uint32_t noneFoundations = none & (0xFu << (Cascades + Cells));
+
+    // The destinations of each top card come from the card masks, in the
+    // same ascending order of board column as checking every pair would.
+    CardMaskT playable = (m_tops | m_cells) & m_next;
+    moves.clear();
+    for (unsigned int s = 0; s < Columns; s++) {
+        if (empty[s]) {
             continue;
         }
 
-        for (auto b : positions) {
-            if (a == b) {
+        CardCodeT c = top[s];
+        uint32_t dsts = noneCells;
+        if (cardBit(c) & playable) {
+            dsts |= codeRank(c) == Ace ? noneFoundations : 1u << m_where[c - 1];
+        }
+        for (CardMaskT t = stackTargets(CardT(c)); t != 0; t &= t - 1) {
+            dsts |= 1u << m_where[__builtin_ctzll(t)];
+        }
+        if (canStack<V>(c, true, 0)) {
+            dsts |= noneCascades;
+        }
+        moves.pushAll(s, dsts);
+    }
+
+    if (!supermoves) {
+        return;
+    }
+
+    unsigned int capacity = supermoveCapacity(false);
+    unsigned int emptyCapacity = supermoveCapacity(true);
+    for (unsigned int s = 0; s < Cascades; s++) {
+        unsigned int run = topRun<V>(m_cols[s]);
+        if (run < 2) {
+            continue;
+        }
+
+        const CardT * end = m_cols[s].end();
+        for (unsigned int d = 0; d < Cascades; d++) {
+            if (d == s) {
                 continue;
             }
 
-            std::tie(q, j) = b;
-            if (isValidMove(p, i, q, j)) {
-                return false;
+            if (empty[d]) {
+                for (unsigned int n = 2; n <= run && n <= emptyCapacity; n++) {
+                    if (canStack<V>(end[-static_cast<int>(n)].code(), true, 0)) {
+                        moves.push(MoveT(s, d, n));
+                    }
+                }
+            } else {
+                // Only the card one rank below the destination can go on
+                // it, which fixes the length of the run.
+                int n = static_cast<int>(codeRank(top[d])) - static_cast<int>(codeRank(top[s]));
+                if (n >= 2 && n <= static_cast<int>(run) && n <= static_cast<int>(capacity) &&
+                        canStack<V>(end[-n].code(), false, top[d])) {
+                    moves.push(MoveT(s, d, n));
+                }
             }
         }
     }
+}
 
-    return true;
+
+template <class V>
+void BasicGameT<V>::performMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) {
+    STAT_CALL(StatGamePerformMove);
+    throwMoveStatus(tryMove(p, i, q, j));
 }
 
 
-void GameT::performMove(PlacementT p, unsigned int i, PlacementT q, unsigned int j) {
-    bool isValid = isValidPlacement(p, i) && isValidPlacement(q, j);
-    if (!isValid) {
-        throw invalid_placement();
+template <class V>
+void BasicGameT<V>::performMove(MoveT m) {
+    STAT_CALL(StatGamePerformMove);
+    throwMoveStatus(tryMove(m));
+}
+
+
+template <class V>
+void BasicGameT<V>::applyMove(unsigned int s, unsigned int d, unsigned int n) {
+    record(s, d, n, false);
+    transfer(s, d, n);
+    if (m_autoplay) {
+        autoplay();
     }
+}
 
-    if (!isValidMove(p, i, q, j)) {
-        throw invalid_move();
+
+template <class V>
+void BasicGameT<V>::record(unsigned int s, unsigned int d, unsigned int n, bool automatic) {
+    JournalEntryT e;
+    e.src = static_cast<unsigned char>(s);
+    e.dst = static_cast<unsigned char>(d);
+    e.card = m_cols[s].end()[-static_cast<int>(n)].code();
+    e.count = static_cast<unsigned char>(n);
+    e.automatic = automatic;
+    m_journal.record(e);
+}
+
+
+// Whether a card may go to the foundations without any card still in play
+// needing it, given the foundation heights. When building by suit only the
+// card below it could need it, and that card is already on the foundations.
+template <class V>
+static bool isSafe(CardCodeT c, FoundationHeightsT heights) {
+    RankT r = codeRank(c);
+    if (V::SameSuit || r <= 2) {
+        return true;
     }
 
-    Stack<CardT> &src = getCol(p, i);
-    Stack<CardT> &dst = getCol(q, j);
-    dst.push(src.peek());
-    src.pop();
+    // Black suits are enumerated first, so the opposite colour of a suit is
+    // the pair of suits at the other end.
+    SuitT opposite = codeIsRed(c) ? Spades : Hearts;
+    return heightOf(heights, opposite) + 1 >= r &&
+           heightOf(heights, static_cast<SuitT>(opposite + 1)) + 1 >= r;
 }
 
 
-Stack<CardT> & GameT::getCol(PlacementT p, unsigned int i) {
-    if (!isValidPlacement(p, i)) {
-        throw invalid_placement();
+template <class V>
+unsigned int BasicGameT<V>::autoplay() {
+    STAT_CALL(StatGameAutoplay);
+    sync();
+    int foundation[4] = { -1, -1, -1, -1 };
+    for (unsigned int x = Cascades + Cells; x < Columns; x++) {
+        if (!m_cols[x].isEmpty()) {
+            foundation[m_cols[x].peek().suit()] = x;
+        }
+    }
+
+    unsigned int moved = 0;
+    for (bool progress = true; progress; ) {
+        progress = false;
+        // The playable cards hold at most one card per suit, so moving one
+        // leaves the others playable.
+        CardMaskT ready = (m_tops | m_cells) & m_next;
+        for (; ready != 0; ready &= ready - 1) {
+            CardCodeT c = static_cast<CardCodeT>(__builtin_ctzll(ready));
+            if (!isSafe<V>(c, m_heights)) {
+                continue;
+            }
+
+            unsigned int s = m_where[c];
+            SuitT suit = codeSuit(c);
+
+            if (foundation[suit] < 0) {
+                for (unsigned int x = Cascades + Cells; foundation[suit] < 0; x++) {
+                    if (m_cols[x].isEmpty()) {
+                        foundation[suit] = x;
+                    }
+                }
+            }
+
+            record(s, foundation[suit], 1, true);
+            transfer(s, foundation[suit]);
+            moved++;
+            progress = true;
+        }
+    }
+
+    return moved;
+}
+
+
+template <class V>
+void BasicGameT<V>::setAutoplay(bool on) {
+    m_autoplay = on;
+}
+
+
+template <class V>
+void BasicGameT<V>::setJournaling(bool on) {
+    m_journal.setEnabled(on);
+}
+
+
+template <class V>
+bool BasicGameT<V>::isJournaling() const {
+    return m_journal.isEnabled();
+}
+
+
+template <class V>
+void BasicGameT<V>::transfer(unsigned int s, unsigned int d, unsigned int n) {
+    sync();
+    // The run stays in place in the source until it has been copied, and
+    // the columns are distinct, so it can be read straight out of it.
+    unmarkColumn(s);
+    unmarkColumn(d);
+
+    const CardT * run = m_cols[s].end() - n;
+    unsigned int depth = m_cols[s].size() - n;
+    uint64_t srcHash = m_colHash[s];
+    uint64_t dstHash = m_colHash[d];
+    for (unsigned int k = 0; k < n; k++) {
+        CardCodeT c = run[k].code();
+        srcHash ^= zobristKey(c, depth + k);
+        dstHash ^= zobristKey(c, m_cols[d].size());
+        m_where[c] = static_cast<unsigned char>(d);
+        m_cols[d].push(run[k]);
+    }
+    for (unsigned int k = 0; k < n; k++) {
+        m_cols[s].pop();
     }
 
-    switch (p) {
+    setColumnHash(s, srcHash);
+    setColumnHash(d, dstHash);
+    markColumn(s);
+    markColumn(d);
+}
+
+
+template <class V>
+void BasicGameT<V>::unmarkColumn(unsigned int x) {
+    if (m_cols[x].isEmpty()) {
+        return;
+    }
+
+    CardMaskT top = cardBit(m_cols[x].peek().code());
+    switch (placement(x)) {
         case Cascade:
-            return m_cols[i];
+            m_tops &= ~top;
+            break;
         case Cell:
-            return m_cols[i + 8];
+            m_cells &= ~top;
+            break;
         case Foundation:
-            return m_cols[i + 12];
+            break;
     }
+}
+
 
-    return m_cols[0];  // This cannot happen, the switch;case is complete.
+template <class V>
+void BasicGameT<V>::markColumn(unsigned int x) const {
+    switch (placement(x)) {
+        case Cascade:
+            if (!m_cols[x].isEmpty()) {
+                m_tops |= cardBit(m_cols[x].peek().code());
+            }
+            break;
+        case Cell:
+            if (!m_cols[x].isEmpty()) {
+                m_cells |= cardBit(m_cols[x].peek().code());
+            }
+            break;
+        case Foundation: {
+            // A foundation can gain or lose its suit, so every suit's height
+            // and next card are recomputed from the four of them.
+            m_heights = 0;
+            for (unsigned int f = Cascades + Cells; f < Columns; f++) {
+                if (!m_cols[f].isEmpty()) {
+                    CardCodeT top = m_cols[f].peek().code();
+                    m_heights |= static_cast<FoundationHeightsT>(codeRank(top)) << (8 * codeSuit(top));
+                }
+            }
+            m_next = 0;
+            for (unsigned int suit = 0; suit < 4; suit++) {
+                RankT height = heightOf(m_heights, static_cast<SuitT>(suit));
+                if (height < King) {
+                    m_next |= cardBit(packCard(static_cast<SuitT>(suit), height + 1));
+                }
+            }
+            break;
+        }
+    }
 }
+
+
+template <class V>
+void BasicGameT<V>::remask() const {
+    m_tops = 0;
+    m_cells = 0;
+    m_where.fill(Columns);
+    for (unsigned int x = 0; x < Columns; x++) {
+        for (CardT c : m_cols[x]) {
+            m_where[c.code()] = static_cast<unsigned char>(x);
+        }
+        markColumn(x);
+    }
+}
+
+
+template <class V>
+void BasicGameT<V>::setColumnHash(unsigned int x, uint64_t h) {
+    uint64_t salt = zobristSalt(x);
+    uint64_t groupSalt = zobristSalt(column(placement(x), 0));
+    m_hash ^= zobristMix(m_colHash[x] ^ salt) ^ zobristMix(h ^ salt);
+    m_canonicalHash ^= zobristMix(m_colHash[x] ^ groupSalt) ^ zobristMix(h ^ groupSalt);
+    m_colHash[x] = h;
+}
+
+
+template <class V>
+void BasicGameT<V>::rehash() const {
+    m_hash = 0;
+    m_canonicalHash = 0;
+    for (unsigned int x = 0; x < Columns; x++) {
+        uint64_t h = 0;
+        unsigned int depth = 0;
+        for (CardT c : m_cols[x]) {
+            h ^= zobristKey(c.code(), depth++);
+        }
+
+        m_colHash[x] = h;
+        m_hash ^= zobristMix(h ^ zobristSalt(x));
+        m_canonicalHash ^= zobristMix(h ^ zobristSalt(column(placement(x), 0)));
+    }
+}
+
+
+template <class V>
+CardMaskT BasicGameT<V>::topMask() const {
+    sync();
+    return m_tops;
+}
+
+
+template <class V>
+CardMaskT BasicGameT<V>::cellMask() const {
+    sync();
+    return m_cells;
+}
+
+
+template <class V>
+CardMaskT BasicGameT<V>::foundationMask() const {
+    sync();
+    return m_next;
+}
+
+
+template <class V>
+CardMaskT BasicGameT<V>::stackTargets(CardT c) const {
+    sync();
+    RankT r = c.rank();
+    if (r == King) {
+        return 0;
+    }
+
+    if (V::SameSuit) {
+        return m_tops & cardBit(c.code() + 1);
+    }
+
+    // The card one rank higher in the two suits of the other colour. Black
+    // suits take the low 32 bits and red suits the high 32 bits.
+    CardMaskT above = cardBit(r + 1) | cardBit(r + 1) << 16;
+    return m_tops & (c.isRed() ? above : above << 32);
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::columnOf(CardT c) const {
+    sync();
+    return m_where[c.code()];
+}
+
+
+template <class V>
+uint64_t BasicGameT<V>::hash() const {
+    sync();
+    return m_hash;
+}
+
+
+template <class V>
+uint64_t BasicGameT<V>::canonicalHash() const {
+    sync();
+    return m_canonicalHash;
+}
+
+
+template <class V>
+void BasicGameT<V>::undoMove() {
+    STAT_CALL(StatGameUndoMove);
+    unsigned int n = m_journal.undo();
+    for (unsigned int k = m_journal.applied() + n; k-- > m_journal.applied(); ) {
+        const JournalEntryT &e = m_journal[k];
+        transfer(e.dst, e.src, e.count);
+    }
+}
+
+
+template <class V>
+void BasicGameT<V>::redoMove() {
+    STAT_CALL(StatGameRedoMove);
+    unsigned int n = m_journal.redo();
+    for (unsigned int k = m_journal.applied() - n; k < m_journal.applied(); k++) {
+        const JournalEntryT &e = m_journal[k];
+        transfer(e.src, e.dst, e.count);
+    }
+}
+
+
+template <class V>
+void BasicGameT<V>::rewind(unsigned int n) {
+    STAT_CALL(StatGameRewind);
+    if (n > m_journal.undoCount()) {
+        throw empty_history();
+    }
+
+    for (unsigned int k = 0; k < n; k++) {
+        undoMove();
+    }
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::undoCount() const {
+    return m_journal.undoCount();
+}
+
+
+template <class V>
+unsigned int BasicGameT<V>::redoCount() const {
+    return m_journal.redoCount();
+}
+
+
+template <class V>
+void BasicGameT<V>::history(std::vector<MoveT> & out) const {
+    STAT_CALL(StatGameHistory);
+    m_journal.history(out);
+}
+
+
+template <class V>
+void BasicGameT<V>::clearHistory() {
+    m_journal.clear();
+}
+
+
+template <class V>
+void BasicGameT<V>::resync() const {
+    rehash();
+    remask();
+    m_stale = false;
+}
+
+
+template <class V>
+ColumnT & BasicGameT<V>::getCol(PlacementT p, unsigned int i) {
+    const ColumnT &col = static_cast<const BasicGameT &>(*this).getCol(p, i);
+    // The column may change after this returns, so the hashes and masks are
+    // recomputed when next read rather than now.
+    m_stale = true;
+    return const_cast<ColumnT &>(col);
+}
+
+
+template <class V>
+const ColumnT & BasicGameT<V>::getCol(PlacementT p, unsigned int i) const {
+    STAT_CALL(StatGameGetCol);
+    if (!isValidPlacement(p, i)) {
+        throw invalid_placement();
+    }
+
+    return m_cols[column(p, i)];
+}
+
+
+constexpr unsigned int FreeCell::Cascades;
+constexpr unsigned int FreeCell::Cells;
+constexpr unsigned int FreeCell::DealtToCells;
+constexpr unsigned int BakersGame::Cascades;
+constexpr unsigned int BakersGame::Cells;
+constexpr unsigned int BakersGame::DealtToCells;
+constexpr unsigned int EightOff::Cascades;
+constexpr unsigned int EightOff::Cells;
+constexpr unsigned int EightOff::DealtToCells;
+constexpr unsigned int Seahaven::Cascades;
+constexpr unsigned int Seahaven::Cells;
+constexpr unsigned int Seahaven::DealtToCells;
+constexpr unsigned int TwoCellFreeCell::Cascades;
+constexpr unsigned int TwoCellFreeCell::Cells;
+constexpr unsigned int TwoCellFreeCell::DealtToCells;
+
+template class BasicGameT<FreeCell>;
+template class BasicGameT<BakersGame>;
+template class BasicGameT<EightOff>;
+template class BasicGameT<Seahaven>;
+template class BasicGameT<TwoCellFreeCell>;
@@ -0,0 +1,115 @@
+/**
+ * \file JournalADT.cpp
+ * \author agent <agent@local>
+ */
+#include "Exceptions.h"
+#include "JournalADT.h"
+#include "StatsADT.h"
+
+
+JournalT::JournalT() :
+    m_applied(0),
+    m_undoable(0),
+    m_recorded(0),
+    m_enabled(false)
+{}
+
+
+JournalT::JournalT(const JournalT & j) :
+    m_applied(j.m_applied),
+    m_undoable(j.m_undoable),
+    m_recorded(j.m_recorded),
+    m_enabled(j.m_enabled)
+{
+    statAssign(m_entries, j.m_entries);
+}
+
+
+JournalT & JournalT::operator=(const JournalT & j) {
+    statAssign(m_entries, j.m_entries);
+    m_applied = j.m_applied;
+    m_undoable = j.m_undoable;
+    m_recorded = j.m_recorded;
+    m_enabled = j.m_enabled;
+    return *this;
+}
+
+
+void JournalT::setEnabled(bool on) {
+    m_enabled = on;
+    if (!on) {
+        clear();
+    }
+}
+
+
+bool JournalT::isEnabled() const {
+    return m_enabled;
+}
+
+
+bool JournalT::beginsMove(unsigned int k) const {
+    return k == 0 || !m_entries[k].automatic;
+}
+
+
+void JournalT::record(const JournalEntryT & e) {
+    if (!m_enabled) {
+        return;
+    }
+
+    // A new move discards any moves which were undone.
+    m_entries.resize(m_applied);
+    m_recorded = m_undoable;
+    statPushBack(m_entries, e);
+    if (beginsMove(m_applied)) {
+        m_undoable++;
+        m_recorded++;
+    }
+    m_applied++;
+}
+
+
+unsigned int JournalT::undo() {
+    if (m_applied == 0) {
+        throw empty_history();
+    }
+
+    unsigned int end = m_applied;
+    do {
+        m_applied--;
+    } while (!beginsMove(m_applied));
+    m_undoable--;
+    return end - m_applied;
+}
+
+
+unsigned int JournalT::redo() {
+    if (m_applied == m_entries.size()) {
+        throw empty_history();
+    }
+
+    unsigned int start = m_applied;
+    do {
+        m_applied++;
+    } while (m_applied < m_entries.size() && !beginsMove(m_applied));
+    m_undoable++;
+    return m_applied - start;
+}
+
+
+void JournalT::history(std::vector<MoveT> & out) const {
+    out.clear();
+    for (unsigned int k = 0; k < m_applied; k++) {
+        const JournalEntryT &e = m_entries[k];
+        statPushBack(out, MoveT(e.src, e.dst, e.count));
+    }
+}
+
+
+void JournalT::clear() {
+    m_entries.clear();
+    m_applied = 0;
+    m_undoable = 0;
+    m_recorded = 0;
+}
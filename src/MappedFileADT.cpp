@@ -0,0 +1,63 @@
+/**
+ * \file MappedFileADT.cpp
+ * \author agent <agent@local>
+ */
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Exceptions.h"
+#include "MappedFileADT.h"
+
+
+MappedFileT::MappedFileT(const std::string & path, const char * magic, unsigned long magicBytes,
+                         unsigned long minBytes) :
+    m_map(0),
+    m_bytes(0)
+{
+    if (minBytes < magicBytes) {
+        minBytes = magicBytes;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw io_error();
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(minBytes)) {
+        close(fd);
+        throw io_error();
+    }
+
+    void * map = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw io_error();
+    }
+
+    if (std::memcmp(map, magic, magicBytes) != 0) {
+        munmap(map, st.st_size);
+        throw io_error();
+    }
+    m_map = static_cast<const unsigned char *>(map);
+    m_bytes = st.st_size;
+}
+
+
+MappedFileT::~MappedFileT() {
+    munmap(const_cast<unsigned char *>(m_map), m_bytes);
+}
+
+
+const unsigned char * MappedFileT::data() const {
+    return m_map;
+}
+
+
+unsigned long MappedFileT::size() const {
+    return m_bytes;
+}
@@ -0,0 +1,123 @@
+/**
+ * \file MoveLogADT.cpp
+ * \author agent <agent@local>
+ */
+#include "Exceptions.h"
+#include "MoveLogADT.h"
+
+
+static const char MAGIC[8] = { 'F', 'C', 'M', 'L', 'O', 'G', '0', '1' };
+
+static const unsigned long HEADER_SIZE = 13;
+
+
+MoveLogWriterT::MoveLogWriterT(const std::string & path) :
+    m_out(path.c_str(), std::ios::binary | std::ios::trunc)
+{
+    if (!m_out.write(MAGIC, sizeof(MAGIC))) {
+        throw io_error();
+    }
+}
+
+
+void MoveLogWriterT::write(uint64_t seed, DealT mode, const std::vector<MoveT> & moves) {
+    unsigned char header[HEADER_SIZE];
+    header[0] = static_cast<unsigned char>(mode);
+    for (unsigned int k = 0; k < 8; k++) {
+        header[1 + k] = static_cast<unsigned char>(seed >> (8 * k));
+    }
+    std::vector<unsigned char> packed(2 * moves.size());
+    uint32_t length = 0;
+    for (unsigned int k = 0; k < moves.size(); k++) {
+        length += packMove(moves[k], &packed[length]);
+    }
+    for (unsigned int k = 0; k < 4; k++) {
+        header[9 + k] = static_cast<unsigned char>(length >> (8 * k));
+    }
+
+    m_out.write(reinterpret_cast<const char *>(header), HEADER_SIZE);
+    if (!m_out.write(reinterpret_cast<const char *>(packed.data()), length)) {
+        throw io_error();
+    }
+}
+
+
+void MoveLogWriterT::close() {
+    m_out.close();
+    if (!m_out) {
+        throw io_error();
+    }
+}
+
+
+MoveLogReaderT::MoveLogReaderT(const std::string & path) :
+    m_file(path, MAGIC, sizeof(MAGIC)),
+    m_offset(sizeof(MAGIC))
+{
+}
+
+
+bool MoveLogReaderT::next(MoveLogRecordT & r) {
+    unsigned long bytes = m_file.size();
+    if (m_offset == bytes) {
+        return false;
+    }
+    if (bytes - m_offset < HEADER_SIZE) {
+        throw io_error();
+    }
+
+    const unsigned char * header = m_file.data() + m_offset;
+    if (header[0] != MicrosoftDeal && header[0] != FastDeal) {
+        throw io_error();
+    }
+    r.mode = static_cast<DealT>(header[0]);
+    r.seed = 0;
+    for (unsigned int k = 0; k < 8; k++) {
+        r.seed |= static_cast<uint64_t>(header[1 + k]) << (8 * k);
+    }
+    r.length = 0;
+    for (unsigned int k = 0; k < 4; k++) {
+        r.length |= static_cast<uint32_t>(header[9 + k]) << (8 * k);
+    }
+
+    if (bytes - m_offset - HEADER_SIZE < r.length) {
+        throw io_error();
+    }
+    r.moves = header + HEADER_SIZE;
+    m_offset += HEADER_SIZE + r.length;
+    return true;
+}
+
+
+MoveStatusT replayMoves(GameT & g, const unsigned char * moves, unsigned long length,
+                        bool validate, unsigned long & applied) {
+    const unsigned char * end = moves + length;
+    for (applied = 0; moves != end; applied++) {
+        MoveT m;
+        unsigned int n = unpackMove(moves, end, m);
+        if (n == 0) {
+            return MoveInvalid;
+        }
+
+        if (validate) {
+            MoveStatusT status = g.tryMove(m);
+            if (status != MoveOk) {
+                return status;
+            }
+        } else {
+            g.applyTrusted(m);
+        }
+        moves += n;
+    }
+
+    return MoveOk;
+}
+
+
+MoveStatusT replay(const MoveLogRecordT & r, GameT & g, bool validate) {
+    bool journaling = g.isJournaling();
+    g = GameT(r.seed, r.mode);
+    g.setJournaling(journaling);
+    unsigned long applied;
+    return replayMoves(g, r.moves, r.length, validate, applied);
+}
@@ -0,0 +1,395 @@
+/**
+ * \file NotationADT.cpp
+ * \author agent <agent@local>
+ */
+#include <cstring>
+
+#include "Exceptions.h"
+#include "NotationADT.h"
+
+
+static const char RANKS[] = "0A23456789TJQK";
+static const char SUITS[] = "SCHD";
+
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+
+// Advances `p` past whitespace and returns the end of the token there.
+static const char * token(const char *& p, const char * end) {
+    while (p != end && isSpace(*p)) {
+        p++;
+    }
+    const char * q = p;
+    while (q != end && !isSpace(*q)) {
+        q++;
+    }
+    return q;
+}
+
+
+// Returns the rank of the rank characters [begin, end), or 0 if they are
+// not one.
+static RankT rankOf(const char * begin, const char * end) {
+    if (end - begin == 2 && begin[0] == '1' && begin[1] == '0') {
+        return 10;
+    }
+    if (end - begin != 1) {
+        return 0;
+    }
+    const char * r = std::strchr(RANKS + 1, *begin);
+    return *begin != '\0' && r ? static_cast<RankT>(r - RANKS) : 0;
+}
+
+
+// Returns the suit named by `c`, or -1 if it does not name one.
+static int suitOf(char c) {
+    const char * s = std::strchr(SUITS, c);
+    return c != '\0' && s ? static_cast<int>(s - SUITS) : -1;
+}
+
+
+CardCodeT parseCard(const char * begin, const char * end) {
+    if (end - begin < 2) {
+        throw invalid_notation();
+    }
+
+    RankT r = rankOf(begin, end - 1);
+    int s = suitOf(end[-1]);
+    if (r == 0 || s < 0) {
+        throw invalid_notation();
+    }
+
+    return packCard(static_cast<SuitT>(s), r);
+}
+
+
+void formatCard(CardCodeT c, std::string & out) {
+    out += RANKS[codeRank(c)];
+    out += SUITS[codeSuit(c)];
+}
+
+
+// Board column named by a move character, or -1. Foundations are named by
+// the first of them.
+static int columnOf(char c) {
+    if (c >= '1' && c <= '8') {
+        return c - '1';
+    }
+    if (c >= 'a' && c <= 'd') {
+        return 8 + (c - 'a');
+    }
+    if (c == 'h') {
+        return 12;
+    }
+    return -1;
+}
+
+
+MoveT parseMove(const GameT & g, const char * begin, const char * end) {
+    if (end - begin < 2) {
+        throw invalid_notation();
+    }
+
+    int s = columnOf(begin[0]);
+    int d = columnOf(begin[1]);
+    if (s < 0 || d < 0 || s == d) {
+        throw invalid_notation();
+    }
+
+    // A supermove is suffixed with the number of cards it moves.
+    if (end - begin > 2) {
+        unsigned int n = 0;
+        for (const char * p = begin + 2; p != end; p++) {
+            if (*p < '0' || *p > '9' || n > 13) {
+                throw invalid_notation();
+            }
+            n = 10 * n + (*p - '0');
+        }
+        if (n < 2 || n > 13 || s >= 8 || d >= 8) {
+            throw invalid_notation();
+        }
+        return MoveT(s, d, n);
+    }
+
+    // Resolve "h" to the foundation the move is valid for.
+    for (unsigned int k = 0; k < 4; k++) {
+        unsigned int src = s == 12 ? 12 + k : s;
+        unsigned int dst = d == 12 ? 12 + k : d;
+        if (g.checkMove(GameT::placement(src), GameT::position(src),
+                        GameT::placement(dst), GameT::position(dst)) == MoveOk) {
+            return MoveT(src, dst);
+        }
+        if (s != 12 && d != 12) {
+            break;
+        }
+    }
+
+    return MoveT(s, d);
+}
+
+
+// Move character naming a board column.
+static char moveChar(unsigned int col) {
+    switch (GameT::placement(col)) {
+        case Cascade:
+            return static_cast<char>('1' + col);
+        case Cell:
+            return static_cast<char>('a' + GameT::position(col));
+        case Foundation:
+            return 'h';
+    }
+
+    return '?';
+}
+
+
+void formatMove(MoveT m, std::string & out) {
+    out += moveChar(m.src());
+    out += moveChar(m.dst());
+    if (m.count() >= 10) {
+        out += '1';
+    }
+    if (m.count() > 1) {
+        out += static_cast<char>('0' + m.count() % 10);
+    }
+}
+
+
+void parseMoves(const GameT & g, const std::string & text, std::vector<MoveT> & out) {
+    out.clear();
+    GameT board(g);
+    const char * p = text.data();
+    const char * end = p + text.size();
+    for (const char * q = token(p, end); p != end; q = token(p, end)) {
+        MoveT m = parseMove(board, p, q);
+        if (board.tryMove(m) != MoveOk) {
+            throw invalid_move();
+        }
+        out.push_back(m);
+        p = q;
+    }
+}
+
+
+void formatMoves(const std::vector<MoveT> & moves, std::string & out) {
+    for (unsigned int k = 0; k < moves.size(); k++) {
+        if (k > 0) {
+            out += ' ';
+        }
+        formatMove(moves[k], out);
+    }
+}
+
+
+BoardParserT::BoardParserT() {
+    reset();
+}
+
+
+void BoardParserT::reset() {
+    for (int i = 0; i < 8; i++) {
+        m_cols[i] = ColumnT(19);
+    }
+    for (int i = 8; i < 12; i++) {
+        m_cols[i] = ColumnT(1);
+    }
+    for (int i = 12; i < 16; i++) {
+        m_cols[i] = ColumnT(13);
+    }
+    m_cascades = 0;
+    m_cells = 0;
+}
+
+
+// Whether [begin, end) starts with the label `label`.
+static bool hasLabel(const char * begin, const char * end, const char * label) {
+    unsigned long n = std::strlen(label);
+    return static_cast<unsigned long>(end - begin) >= n && std::memcmp(begin, label, n) == 0;
+}
+
+
+bool BoardParserT::feed(const char * begin, const char * end) {
+    // A completed board must be taken with game() before the next is fed.
+    if (m_cascades == 8) {
+        throw invalid_notation();
+    }
+
+    const char * p = begin;
+    const char * q = token(p, end);
+    if (p == end || *p == '#') {
+        return false;
+    }
+
+    if (hasLabel(p, end, "Foundations:")) {
+        if (m_cascades > 0) {
+            throw invalid_notation();
+        }
+        p += std::strlen("Foundations:");
+        unsigned int next = 12;
+        for (q = token(p, end); p != end; p = q, q = token(p, end)) {
+            // Each token is a suit, a dash and the top rank or 0.
+            int s = suitOf(*p);
+            if (q - p < 3 || s < 0 || p[1] != '-') {
+                throw invalid_notation();
+            }
+            bool none = q - p == 3 && p[2] == '0';
+            RankT top = none ? 0 : rankOf(p + 2, q);
+            if (top == 0 && !none) {
+                throw invalid_notation();
+            }
+            if (top > 0) {
+                if (next == 16 || !m_cols[next].isEmpty()) {
+                    throw invalid_notation();
+                }
+                for (RankT r = Ace; r <= top; r++) {
+                    m_cols[next].push(CardT(static_cast<SuitT>(s), r));
+                }
+                next++;
+            }
+        }
+        return false;
+    }
+
+    if (hasLabel(p, end, "Freecells:")) {
+        if (m_cascades > 0) {
+            throw invalid_notation();
+        }
+        p += std::strlen("Freecells:");
+        for (q = token(p, end); p != end; p = q, q = token(p, end)) {
+            if (m_cells == 4) {
+                throw invalid_notation();
+            }
+            if (!(q - p == 1 && *p == '-')) {
+                m_cols[8 + m_cells].push(CardT(parseCard(p, q)));
+            }
+            m_cells++;
+        }
+        return false;
+    }
+
+    if (*p == ':') {
+        p++;
+    }
+    ColumnT &cascade = m_cols[m_cascades];
+    for (q = token(p, end); p != end; p = q, q = token(p, end)) {
+        if (cascade.isFull()) {
+            throw invalid_notation();
+        }
+        cascade.push(CardT(parseCard(p, q)));
+    }
+    return ++m_cascades == 8;
+}
+
+
+GameT BoardParserT::game() {
+    // Codes are below 64, so one bit per code finds repeated cards.
+    uint64_t seen = 0;
+    unsigned int total = 0;
+    for (const ColumnT &col : m_cols) {
+        for (CardT c : col) {
+            uint64_t bit = 1ULL << c.code();
+            if (seen & bit) {
+                reset();
+                throw invalid_board();
+            }
+            seen |= bit;
+            total++;
+        }
+    }
+    if (total != 52) {
+        reset();
+        throw invalid_board();
+    }
+
+    GameT g(m_cols);
+    reset();
+    return g;
+}
+
+
+GameT parseBoard(const std::string & text) {
+    BoardParserT parser;
+    const char * p = text.data();
+    const char * end = p + text.size();
+    while (p != end) {
+        const char * eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!eol) {
+            eol = end;
+        }
+        if (parser.feed(p, eol)) {
+            return parser.game();
+        }
+        p = eol == end ? end : eol + 1;
+    }
+
+    throw invalid_notation();
+}
+
+
+void formatBoard(const GameT & g, std::string & out) {
+    out += "Foundations:";
+    for (unsigned int s = 0; s < 4; s++) {
+        RankT top = 0;
+        for (unsigned int j = 0; j < 4; j++) {
+            const ColumnT &f = g.getCol(Foundation, j);
+            if (!f.isEmpty() && f.peek().suit() == static_cast<SuitT>(s)) {
+                top = f.peek().rank();
+            }
+        }
+        out += ' ';
+        out += SUITS[s];
+        out += '-';
+        out += top == 0 ? '0' : RANKS[top];
+    }
+
+    out += "\nFreecells:";
+    for (unsigned int j = 0; j < 4; j++) {
+        const ColumnT &c = g.getCol(Cell, j);
+        out += ' ';
+        if (c.isEmpty()) {
+            out += '-';
+        } else {
+            formatCard(c.peek().code(), out);
+        }
+    }
+    out += '\n';
+
+    for (unsigned int i = 0; i < 8; i++) {
+        out += ':';
+        for (CardT c : g.getCol(Cascade, i)) {
+            out += ' ';
+            formatCard(c.code(), out);
+        }
+        out += '\n';
+    }
+}
+
+
+BoardReaderT::BoardReaderT(std::istream & in) :
+    m_in(in)
+{}
+
+
+bool BoardReaderT::next(GameT & g) {
+    bool started = false;
+    while (std::getline(m_in, m_line)) {
+        const char * p = m_line.data();
+        const char * end = p + m_line.size();
+        if (m_parser.feed(p, end)) {
+            g = m_parser.game();
+            return true;
+        }
+        const char * q = p;
+        token(q, end);
+        started = started || (q != end && *q != '#');
+    }
+
+    if (started) {
+        m_parser.reset();
+        throw invalid_notation();
+    }
+    return false;
+}
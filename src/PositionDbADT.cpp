@@ -0,0 +1,263 @@
+/**
+ * \file PositionDbADT.cpp
+ * \author agent <agent@local>
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Exceptions.h"
+#include "PositionDbADT.h"
+
+
+static const char MAGIC[8] = { 'F', 'C', 'P', 'O', 'S', 'D', 'B', '1' };
+
+// Header: magic, slot count, position count, reserved.
+static const unsigned long HEADER_SIZE = 32;
+
+// Slot: key (8), distance (2), flags (1), card (1), placement (1), onto (1),
+// padding (2). A key of 0 marks an empty slot.
+static const unsigned long SLOT_SIZE = 16;
+
+static const unsigned char WINNABLE_FLAG = 1;
+
+
+// Keys are canonical hashes; a real hash of 0 is stored as 1, as in
+// TranspositionTableT.
+static uint64_t slotKey(uint64_t h) {
+    return h == 0 ? 1 : h;
+}
+
+
+static void encodeSlot(unsigned char * p, uint64_t key, const PositionInfoT & info) {
+    std::memset(p, 0, SLOT_SIZE);
+    std::memcpy(p, &key, sizeof(key));
+    std::memcpy(p + 8, &info.distance, sizeof(info.distance));
+    p[10] = info.winnable ? WINNABLE_FLAG : 0;
+    p[11] = info.best.card;
+    p[12] = info.best.placement;
+    p[13] = info.best.onto;
+}
+
+
+static void decodeSlot(const unsigned char * p, PositionInfoT & info) {
+    std::memcpy(&info.distance, p + 8, sizeof(info.distance));
+    info.winnable = (p[10] & WINNABLE_FLAG) != 0;
+    info.best.card = p[11];
+    info.best.placement = p[12];
+    info.best.onto = p[13];
+}
+
+
+// Whether `a` should replace `b` as the record of a position.
+static bool isBetter(const PositionInfoT & a, const PositionInfoT & b) {
+    if (a.winnable != b.winnable) {
+        return a.winnable;
+    }
+    return a.winnable && a.distance < b.distance;
+}
+
+
+BestMoveT describeMove(const GameT & g, MoveT m) {
+    const ColumnT & src = g.getCol(GameT::placement(m.src()), GameT::position(m.src()));
+    const ColumnT & dst = g.getCol(GameT::placement(m.dst()), GameT::position(m.dst()));
+
+    BestMoveT b;
+    b.card = src.size() < static_cast<int>(m.count()) ? 0 : src.end()[-static_cast<int>(m.count())].code();
+    b.placement = static_cast<uint8_t>(GameT::placement(m.dst()));
+    b.onto = dst.isEmpty() ? 0 : dst.peek().code();
+    return b;
+}
+
+
+bool resolveMove(const GameT & g, BestMoveT b, MoveT & out) {
+    PlacementT q = static_cast<PlacementT>(b.placement);
+    if (q != Cell && q != Foundation && q != Cascade) {
+        return false;
+    }
+
+    for (unsigned int s = 0; s < GameT::column(Foundation, 0); s++) {
+        // The card is the top card moved, or the bottom card of a run.
+        const ColumnT & src = g.getCol(GameT::placement(s), GameT::position(s));
+        unsigned int n = 0;
+        for (const CardT * c = src.end(); c != src.begin() && n == 0; --c) {
+            if (c[-1].code() == b.card) {
+                n = src.end() - c + 1;
+            }
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        for (unsigned int j = 0; j < (q == Cascade ? GameT::Cascades : (q == Cell ? GameT::Cells : GameT::Foundations)); j++) {
+            const ColumnT & dst = g.getCol(q, j);
+            CardCodeT onto = dst.isEmpty() ? 0 : dst.peek().code();
+            MoveT m(s, GameT::column(q, j), n);
+            if (onto == b.onto && g.checkMove(m) == MoveOk) {
+                out = m;
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+
+PositionDbT::PositionDbT(const std::string & path) :
+    m_file(path, MAGIC, sizeof(MAGIC), HEADER_SIZE),
+    m_mask(0),
+    m_count(0)
+{
+    uint64_t slots;
+    std::memcpy(&slots, m_file.data() + 8, sizeof(slots));
+    std::memcpy(&m_count, m_file.data() + 16, sizeof(m_count));
+    if (slots == 0 || (slots & (slots - 1)) != 0 ||
+            m_file.size() != HEADER_SIZE + slots * SLOT_SIZE) {
+        throw io_error();
+    }
+    m_mask = slots - 1;
+}
+
+
+bool PositionDbT::lookup(uint64_t key, PositionInfoT & out) const {
+    key = slotKey(key);
+    // The builder leaves empty slots, but a damaged file might not: give up
+    // after one pass over the table rather than probing forever.
+    uint64_t k = key & m_mask;
+    for (uint64_t n = 0; n <= m_mask; n++, k = (k + 1) & m_mask) {
+        const unsigned char * p = m_file.data() + HEADER_SIZE + k * SLOT_SIZE;
+        uint64_t stored;
+        std::memcpy(&stored, p, sizeof(stored));
+        if (stored == key) {
+            decodeSlot(p, out);
+            return true;
+        }
+        if (stored == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+
+bool PositionDbT::lookup(const GameT & g, PositionInfoT & out) const {
+    return lookup(g.canonicalHash(), out);
+}
+
+
+unsigned long PositionDbT::size() const {
+    return m_count;
+}
+
+
+unsigned long PositionDbT::slots() const {
+    return m_mask + 1;
+}
+
+
+bool PositionDbT::slot(unsigned long k, uint64_t & key, PositionInfoT & out) const {
+    const unsigned char * p = m_file.data() + HEADER_SIZE + k * SLOT_SIZE;
+    std::memcpy(&key, p, sizeof(key));
+    if (key == 0) {
+        return false;
+    }
+    decodeSlot(p, out);
+    return true;
+}
+
+
+void PositionDbBuilderT::add(uint64_t key, const PositionInfoT & info) {
+    key = slotKey(key);
+    std::unordered_map<uint64_t, PositionInfoT>::iterator it = m_positions.find(key);
+    if (it == m_positions.end()) {
+        m_positions.insert(std::make_pair(key, info));
+    } else if (isBetter(info, it->second)) {
+        it->second = info;
+    }
+}
+
+
+void PositionDbBuilderT::addSolution(const GameT & g, const std::vector<MoveT> & moves) {
+    GameT board(g);
+    for (unsigned int k = 0; k < moves.size(); k++) {
+        PositionInfoT info;
+        info.winnable = true;
+        info.distance = static_cast<uint16_t>(moves.size() - k);
+        info.best = describeMove(board, moves[k]);
+        add(board.canonicalHash(), info);
+
+        if (board.tryMove(moves[k]) != MoveOk) {
+            throw invalid_move();
+        }
+    }
+
+    if (board.hasWon()) {
+        PositionInfoT info;
+        info.winnable = true;
+        info.distance = 0;
+        info.best = BestMoveT();
+        add(board.canonicalHash(), info);
+    }
+}
+
+
+void PositionDbBuilderT::merge(const PositionDbT & db) {
+    for (unsigned long k = 0; k < db.slots(); k++) {
+        uint64_t key;
+        PositionInfoT info;
+        if (db.slot(k, key, info)) {
+            add(key, info);
+        }
+    }
+}
+
+
+unsigned long PositionDbBuilderT::size() const {
+    return m_positions.size();
+}
+
+
+void PositionDbBuilderT::write(const std::string & path) const {
+    // Keep the load at most a half, as TranspositionTableT does.
+    uint64_t slots = 1;
+    while (slots < 2 * static_cast<uint64_t>(m_positions.size())) {
+        slots <<= 1;
+    }
+    uint64_t mask = slots - 1;
+    uint64_t count = m_positions.size();
+
+    std::vector<unsigned char> bytes(HEADER_SIZE + slots * SLOT_SIZE, 0);
+    std::memcpy(&bytes[0], MAGIC, sizeof(MAGIC));
+    std::memcpy(&bytes[8], &slots, sizeof(slots));
+    std::memcpy(&bytes[16], &count, sizeof(count));
+
+    std::unordered_map<uint64_t, PositionInfoT>::const_iterator it;
+    for (it = m_positions.begin(); it != m_positions.end(); ++it) {
+        uint64_t k = it->first & mask;
+        for (;;) {
+            unsigned char * p = &bytes[HEADER_SIZE + k * SLOT_SIZE];
+            uint64_t stored;
+            std::memcpy(&stored, p, sizeof(stored));
+            if (stored == 0) {
+                encodeSlot(p, it->first, it->second);
+                break;
+            }
+            k = (k + 1) & mask;
+        }
+    }
+
+    // Write beside the target and rename over it, so readers mapping the
+    // old file never see a partial table.
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char *>(&bytes[0]), bytes.size()) || !out.flush()) {
+            throw io_error();
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw io_error();
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * \file SnapshotADT.cpp
+ * \author agent <agent@local>
+ */
+#include "Exceptions.h"
+#include "SnapshotADT.h"
+
+
+static const char MAGIC[8] = { 'F', 'C', 'S', 'N', 'A', 'P', '0', '1' };
+
+
+SnapshotViewT::SnapshotViewT(const unsigned char * p) :
+    m_p(p)
+{}
+
+
+SnapshotViewT::SnapshotViewT(const SnapshotT & s) :
+    m_p(s.data())
+{}
+
+
+unsigned int SnapshotViewT::length(unsigned int col) const {
+    return m_p[col];
+}
+
+
+CardCodeT SnapshotViewT::card(unsigned int col, unsigned int k) const {
+    unsigned int offset = 16;
+    for (unsigned int x = 0; x < col; x++) {
+        offset += m_p[x];
+    }
+
+    return m_p[offset + k];
+}
+
+
+CardCodeT SnapshotViewT::top(unsigned int col) const {
+    return card(col, m_p[col] - 1);
+}
+
+
+const unsigned char * SnapshotViewT::data() const {
+    return m_p;
+}
+
+
+SnapshotWriterT::SnapshotWriterT(const std::string & path) :
+    m_out(path.c_str(), std::ios::binary | std::ios::trunc)
+{
+    if (!m_out.write(MAGIC, sizeof(MAGIC))) {
+        throw io_error();
+    }
+}
+
+
+void SnapshotWriterT::write(const SnapshotT & s) {
+    if (!m_out.write(reinterpret_cast<const char *>(s.data()), s.size())) {
+        throw io_error();
+    }
+}
+
+
+void SnapshotWriterT::close() {
+    m_out.close();
+    if (!m_out) {
+        throw io_error();
+    }
+}
+
+
+SnapshotFileT::SnapshotFileT(const std::string & path) :
+    m_file(path, MAGIC, sizeof(MAGIC))
+{
+}
+
+
+unsigned long SnapshotFileT::size() const {
+    return (m_file.size() - sizeof(MAGIC)) / SNAPSHOT_SIZE;
+}
+
+
+SnapshotViewT SnapshotFileT::operator[](unsigned long k) const {
+    return SnapshotViewT(m_file.data() + sizeof(MAGIC) + k * SNAPSHOT_SIZE);
+}
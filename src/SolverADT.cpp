@@ -0,0 +1,473 @@
+/**
+ * \file SolverADT.cpp
+ * \author agent <agent@local>
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#include "GameTypes.h"
+#include "SolverADT.h"
+
+
+unsigned int cardsOutside(const GameT & g) {
+    return 52 - g.homeCount();
+}
+
+
+unsigned int cardsOutsideAndBlocking(const GameT & g) {
+    unsigned int h = cardsOutside(g);
+    for (unsigned int j = 0; j < 8; j++) {
+        const ColumnT &s = g.getCol(Cascade, j);
+        if (s.isEmpty()) {
+            continue;
+        }
+
+        // Cards above the lowest card must all move before it can go home.
+        unsigned int k = 0;
+        unsigned int lowest = 0;
+        RankT lowestRank = King + 1;
+        for (CardT c : s) {
+            if (c.rank() < lowestRank) {
+                lowestRank = c.rank();
+                lowest = k;
+            }
+            k++;
+        }
+        h += k - 1 - lowest;
+    }
+
+    return h;
+}
+
+
+SolverConfigT::SolverConfigT() :
+    heuristic(cardsOutsideAndBlocking),
+    weight(2),
+    maxNodes(1000000),
+    maxSeconds(0),
+    threads(0),
+    supermoves(false),
+    autoplay(true)
+{}
+
+
+double SolveResultT::nodesPerSecond() const {
+    return seconds > 0 ? nodes / seconds : 0;
+}
+
+
+SolverT::SolverT(const SolverConfigT & config) :
+    m_config(config),
+    m_seen(config.maxNodes),
+    m_game(std::array<ColumnT, 16>()),
+    m_at(0)
+{
+    m_nodes.reserve(config.maxNodes);
+    m_open.reserve(config.maxNodes);
+}
+
+
+// Moves the working board `g`, currently at node `at`, to the state of node
+// `n`: climbs from both nodes to their common ancestor, undoing moves on the
+// board and remembering the moves to replay down to `n`.
+static void walkTo(GameT & g, const SearchNodeT * nodes, uint32_t & at, uint32_t n, std::vector<MoveT> & path) {
+    path.clear();
+    uint32_t t = n;
+    while (nodes[t].depth > nodes[at].depth) {
+        path.push_back(nodes[t].move);
+        t = nodes[t].parent;
+    }
+    while (nodes[at].depth > nodes[t].depth) {
+        g.undoMove();
+        at = nodes[at].parent;
+    }
+    while (at != t) {
+        g.undoMove();
+        at = nodes[at].parent;
+        path.push_back(nodes[t].move);
+        t = nodes[t].parent;
+    }
+
+    for (auto m = path.rbegin(); m != path.rend(); m++) {
+        g.tryMove(*m);
+    }
+    at = n;
+}
+
+
+// Adds the cards moved by autoplay after each of the searched moves in
+// `moves`, played from `g`, so that they can be replayed without autoplay.
+static void expandAutoplay(const GameT & g, std::vector<MoveT> & moves) {
+    GameT board(g);
+    board.clearHistory();
+    board.setJournaling(true);
+    board.setAutoplay(true);
+    for (MoveT m : moves) {
+        board.tryMove(m);
+    }
+    board.history(moves);
+}
+
+
+// Decides whether a generated move is worth searching. Drops moves off
+// foundations, moves between cells and moves which only differ from an
+// earlier one by which empty column of a kind they use.
+static bool isUseful(const GameT & g, MoveT m) {
+    PlacementT p = GameT::placement(m.src());
+    PlacementT q = GameT::placement(m.dst());
+    if (p == Foundation || (p == Cell && q == Cell)) {
+        return false;
+    }
+
+    if (!g.getCol(q, GameT::position(m.dst())).isEmpty()) {
+        return true;
+    }
+
+    for (unsigned int k = 0; k < GameT::position(m.dst()); k++) {
+        if (g.getCol(q, k).isEmpty()) {
+            return false;
+        }
+    }
+
+    // Moving a whole cascade to another empty cascade changes nothing.
+    return !(p == Cascade && q == Cascade && g.getCol(p, GameT::position(m.src())).size() == static_cast<int>(m.count()));
+}
+
+
+// Writes the moves from the root to node `n` into `out`.
+static void pathTo(const SearchNodeT * nodes, uint32_t n, std::vector<MoveT> & out) {
+    out.resize(nodes[n].depth);
+    for (uint32_t t = n; t != 0; t = nodes[t].parent) {
+        out[nodes[t].depth - 1] = nodes[t].move;
+    }
+}
+
+
+SolveResultT SolverT::solve(const GameT & g) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    SolveResultT result;
+    result.status = Unsolvable;
+
+    m_game = g;
+    m_game.clearHistory();
+    m_game.setJournaling(true);
+    m_game.setAutoplay(m_config.autoplay);
+    m_seen.clear();
+    m_nodes.clear();
+    m_open.clear();
+
+    SearchNodeT root;
+    root.parent = 0;
+    root.depth = 0;
+    m_nodes.push_back(root);
+    m_seen.insert(m_game.canonicalHash());
+    m_at = 0;
+
+    OpenT first;
+    first.priority = 0;
+    first.node = 0;
+    m_open.push_back(first);
+
+    if (m_game.hasWon()) {
+        result.status = Solved;
+    }
+
+    unsigned long expanded = 0;
+    while (result.status == Unsolvable && !m_open.empty()) {
+        if (m_config.maxSeconds > 0 && ++expanded % 256 == 0) {
+            std::chrono::duration<double> spent = Clock::now() - start;
+            if (spent.count() > m_config.maxSeconds) {
+                result.status = TimeLimit;
+                break;
+            }
+        }
+
+        std::pop_heap(m_open.begin(), m_open.end());
+        uint32_t parent = m_open.back().node;
+        m_open.pop_back();
+        walkTo(m_game, m_nodes.data(), m_at, parent, m_path);
+
+        if (m_nodes[parent].depth == UINT16_MAX) {
+            continue;
+        }
+
+        uint16_t depth = m_nodes[parent].depth + 1;
+        m_game.generateMoves(m_moves, m_config.supermoves);
+        for (MoveT m : m_moves) {
+            if (!isUseful(m_game, m)) {
+                continue;
+            }
+
+            m_game.tryMove(m);
+            InsertStatusT seen = m_seen.insert(m_game.canonicalHash());
+            if (seen != InsertDuplicate) {
+                // The table holds at least the node budget, but a full table
+                // must not pass for a state already seen: that would drain
+                // the search and report a solvable deal as Unsolvable.
+                if (seen == InsertFull || m_nodes.size() >= m_config.maxNodes) {
+                    m_game.undoMove();
+                    result.status = NodeLimit;
+                    break;
+                }
+
+                SearchNodeT child;
+                child.parent = parent;
+                child.move = m;
+                child.depth = depth;
+                m_nodes.push_back(child);
+
+                if ((GameT::placement(m.dst()) == Foundation || m_config.autoplay) && m_game.hasWon()) {
+                    pathTo(m_nodes.data(), m_nodes.size() - 1, result.moves);
+                    if (m_config.autoplay) {
+                        expandAutoplay(g, result.moves);
+                    }
+                    result.status = Solved;
+                    m_game.undoMove();
+                    break;
+                }
+
+                OpenT o;
+                uint64_t f = depth + static_cast<uint64_t>(m_config.weight) * m_config.heuristic(m_game);
+                // Among equal estimates prefer the deeper state.
+                o.priority = (f << 16) | (0xFFFF - depth);
+                o.node = m_nodes.size() - 1;
+                m_open.push_back(o);
+                std::push_heap(m_open.begin(), m_open.end());
+            }
+            m_game.undoMove();
+        }
+    }
+
+    result.nodes = m_nodes.size();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+
+struct ParallelSolverT::WorkerT {
+    std::mutex lock;
+    std::deque<uint32_t> items;
+
+    // Only touched by the worker's own thread.
+    GameT game;
+    uint32_t at;
+    GameT::MoveBufferT moves;
+    std::vector<MoveT> path;
+
+    WorkerT() :
+        game(std::array<ColumnT, 16>()),
+        at(0)
+    {}
+};
+
+
+ParallelSolverT::ParallelSolverT(const SolverConfigT & config) :
+    m_config(config),
+    m_threads(config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency())),
+    m_seen(config.maxNodes),
+    m_nodes(config.maxNodes),
+    m_count(0),
+    m_idle(0),
+    m_stop(false),
+    m_status(Unsolvable),
+    m_won(0)
+{
+    for (unsigned int w = 0; w < m_threads; w++) {
+        m_workers.push_back(std::unique_ptr<WorkerT>(new WorkerT()));
+    }
+}
+
+
+ParallelSolverT::~ParallelSolverT() {}
+
+
+unsigned int ParallelSolverT::threads() const {
+    return m_threads;
+}
+
+
+void ParallelSolverT::finish(SolveStatusT status, uint32_t won) {
+    std::lock_guard<std::mutex> guard(m_resultLock);
+    if (!m_stop.load()) {
+        m_status = status;
+        m_won = won;
+        m_stop.store(true);
+    }
+}
+
+
+bool ParallelSolverT::take(unsigned int w, uint32_t & n) {
+    {
+        WorkerT &me = *m_workers[w];
+        std::lock_guard<std::mutex> guard(me.lock);
+        if (!me.items.empty()) {
+            n = me.items.back();
+            me.items.pop_back();
+            return true;
+        }
+    }
+
+    for (unsigned int k = 1; k < m_threads; k++) {
+        WorkerT &victim = *m_workers[(w + k) % m_threads];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.items.empty()) {
+            n = victim.items.front();
+            victim.items.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void ParallelSolverT::work(unsigned int w) {
+    struct ChildT {
+        unsigned int estimate;
+        uint32_t node;
+
+        bool operator<(const ChildT & o) const {
+            return estimate > o.estimate;
+        }
+    };
+
+    WorkerT &me = *m_workers[w];
+    std::array<ChildT, GameT::MoveBufferT::Capacity> children;
+    unsigned long expanded = 0;
+
+    while (!m_stop.load()) {
+        uint32_t n;
+        if (!take(w, n)) {
+            // A worker only counts as idle while it holds no node, so once
+            // every worker is idle there is nothing left anywhere to expand.
+            m_idle++;
+            for (;;) {
+                if (m_stop.load()) {
+                    return;
+                }
+                if (m_idle.load() == m_threads) {
+                    finish(Unsolvable, 0);
+                    return;
+                }
+                std::this_thread::yield();
+                m_idle--;
+                if (take(w, n)) {
+                    break;
+                }
+                m_idle++;
+            }
+        }
+
+        if (m_config.maxSeconds > 0 && ++expanded % 256 == 0 &&
+                std::chrono::steady_clock::now() > m_deadline) {
+            finish(TimeLimit, 0);
+            return;
+        }
+
+        if (m_nodes[n].depth == UINT16_MAX) {
+            continue;
+        }
+
+        walkTo(me.game, m_nodes.data(), me.at, n, me.path);
+        uint16_t depth = m_nodes[n].depth + 1;
+        unsigned int count = 0;
+        me.game.generateMoves(me.moves, m_config.supermoves);
+        for (MoveT m : me.moves) {
+            if (!isUseful(me.game, m)) {
+                continue;
+            }
+
+            me.game.tryMove(m);
+            InsertStatusT seen = m_seen.insert(me.game.canonicalHash());
+            if (seen != InsertDuplicate) {
+                // As in SolverT, a full table means the budget is spent.
+                uint32_t c = m_count.fetch_add(1);
+                if (seen == InsertFull || c >= m_config.maxNodes) {
+                    me.game.undoMove();
+                    finish(NodeLimit, 0);
+                    return;
+                }
+
+                m_nodes[c].parent = n;
+                m_nodes[c].move = m;
+                m_nodes[c].depth = depth;
+
+                if ((GameT::placement(m.dst()) == Foundation || m_config.autoplay) && me.game.hasWon()) {
+                    me.game.undoMove();
+                    finish(Solved, c);
+                    return;
+                }
+
+                children[count].estimate = m_config.heuristic(me.game);
+                children[count].node = c;
+                count++;
+            }
+            me.game.undoMove();
+        }
+
+        // Worst first, so the most promising child is expanded next.
+        std::sort(children.begin(), children.begin() + count);
+        std::lock_guard<std::mutex> guard(me.lock);
+        for (unsigned int k = 0; k < count; k++) {
+            me.items.push_back(children[k].node);
+        }
+    }
+}
+
+
+SolveResultT ParallelSolverT::solve(const GameT & g) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    m_deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(m_config.maxSeconds)
+    );
+
+    m_seen.clear();
+    m_nodes[0].parent = 0;
+    m_nodes[0].depth = 0;
+    m_seen.insert(g.canonicalHash());
+    m_count.store(1);
+    m_idle.store(0);
+    m_stop.store(false);
+    m_status = Unsolvable;
+    m_won = 0;
+    for (std::unique_ptr<WorkerT> &w : m_workers) {
+        w->items.clear();
+        w->game = g;
+        w->game.clearHistory();
+        w->game.setJournaling(true);
+        w->game.setAutoplay(m_config.autoplay);
+        w->at = 0;
+    }
+    m_workers[0]->items.push_back(0);
+
+    if (g.hasWon()) {
+        m_status = Solved;
+    } else {
+        std::vector<std::thread> threads;
+        for (unsigned int w = 1; w < m_threads; w++) {
+            threads.push_back(std::thread(&ParallelSolverT::work, this, w));
+        }
+        work(0);
+        for (std::thread &t : threads) {
+            t.join();
+        }
+    }
+
+    SolveResultT result;
+    result.status = m_status;
+    if (m_status == Solved) {
+        pathTo(m_nodes.data(), m_won, result.moves);
+        if (m_config.autoplay) {
+            expandAutoplay(g, result.moves);
+        }
+    }
+    result.nodes = std::min<unsigned long>(m_count.load(), m_config.maxNodes);
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
@@ -5,53 +5,62 @@
 #include "Exceptions.h"
 #include "CardADT.h"
 #include "StackADT.h"
+#include "StatsADT.h"
 
 
-template <class T>
-Stack<T>::Stack() : m_capacity(0) {}
+template <class T, int N>
+Stack<T, N>::Stack() : m_capacity(0) {}
 
 
-template <class T>
-Stack<T>::Stack(int capacity) :
+template <class T, int N>
+Stack<T, N>::Stack(int capacity) :
     m_s(),
     m_capacity(capacity)
 {
-    if (capacity <= 0) {
+    if (capacity <= 0 || (N > 0 && capacity > N)) {
         throw invalid_capacity();
     }
 }
 
 
-template <class T>
-bool Stack<T>::isEmpty() const {
+template <class T, int N>
+bool Stack<T, N>::isEmpty() const {
     return m_s.size() == 0;
 }
 
 
-template <class T>
-bool Stack<T>::isFull() const {
-    return m_s.size() == m_capacity;
+template <class T, int N>
+bool Stack<T, N>::isFull() const {
+    return static_cast<int>(m_s.size()) == m_capacity;
 }
 
 
-template <class T>
-int Stack<T>::capacity() const {
+template <class T, int N>
+int Stack<T, N>::capacity() const {
     return m_capacity;
 }
 
 
-template <class T>
-void Stack<T>::push(const T v) {
+template <class T, int N>
+int Stack<T, N>::size() const {
+    return m_s.size();
+}
+
+
+template <class T, int N>
+void Stack<T, N>::push(const T v) {
+    STAT_CALL(StatStackPush);
     if (isFull()) {
         throw full();
     }
 
-    m_s.push_back(v);
+    statPushBack(m_s, v);
 }
 
 
-template <class T>
-T Stack<T>::peek() const {
+template <class T, int N>
+T Stack<T, N>::peek() const {
+    STAT_CALL(StatStackPeek);
     if (isEmpty()) {
         throw empty();
     }
@@ -60,8 +69,9 @@ T Stack<T>::peek() const {
 }
 
 
-template <class T>
-void Stack<T>::pop() {
+template <class T, int N>
+void Stack<T, N>::pop() {
+    STAT_CALL(StatStackPop);
     if (isEmpty()) {
         throw empty();
     }
@@ -70,11 +80,28 @@ void Stack<T>::pop() {
 }
 
 
-template <class T>
-std::vector<T> Stack<T>::seq() const {
+template <class T, int N>
+std::vector<T> Stack<T, N>::seq() const {
+    STAT_CALL(StatStackSeq);
+    STAT_ALLOC(m_s.size() * sizeof(T));
     return std::vector<T>(m_s.cbegin(), m_s.cend());
 }
 
 
+template <class T, int N>
+const T * Stack<T, N>::begin() const {
+    return m_s.data();
+}
+
+
+template <class T, int N>
+const T * Stack<T, N>::end() const {
+    return m_s.data() + m_s.size();
+}
+
+
 template class Stack<int>;
 template class Stack<CardT>;
+template class Stack<CardT, 16>;
+template class Stack<CardT, 19>;
+template class Stack<CardT, 64>;
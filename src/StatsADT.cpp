@@ -0,0 +1,97 @@
+/**
+ * \file StatsADT.cpp
+ * \author agent <agent@local>
+ */
+#include "StatsADT.h"
+
+
+static thread_local StatsT t_stats = StatsT();
+
+#ifdef FREECELL_STATS
+// The outermost instrumented call on this thread, or -1 outside of any.
+static thread_local int t_current = -1;
+#endif
+
+
+ApiStatsT StatsT::total() const {
+    ApiStatsT t = { 0, 0, 0 };
+    for (const ApiStatsT &a : api) {
+        t.calls += a.calls;
+        t.allocations += a.allocations;
+        t.bytes += a.bytes;
+    }
+    return t;
+}
+
+
+bool statsEnabled() {
+#ifdef FREECELL_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+StatsT stats() {
+    return t_stats;
+}
+
+
+void resetStats() {
+    t_stats = StatsT();
+}
+
+
+const char * statName(StatApiT a) {
+    static const char * const names[StatApiCount] = {
+        "Stack::push",
+        "Stack::peek",
+        "Stack::pop",
+        "Stack::seq",
+        "GameT::GameT",
+        "GameT::GameT(const GameT &)",
+        "GameT::operator=",
+        "GameT::snapshot",
+        "GameT::getCol",
+        "GameT::isValidMove",
+        "GameT::noValidMoves",
+        "GameT::checkMove",
+        "GameT::tryMove",
+        "GameT::performMove",
+        "GameT::applyTrusted",
+        "GameT::generateMoves",
+        "GameT::autoplay",
+        "GameT::undoMove",
+        "GameT::redoMove",
+        "GameT::rewind",
+        "GameT::history"
+    };
+    return a < StatApiCount ? names[a] : "";
+}
+
+
+#ifdef FREECELL_STATS
+
+StatScopeT::StatScopeT(StatApiT a) : m_outer(t_current) {
+    t_stats.api[a].calls++;
+    if (m_outer < 0) {
+        t_current = a;
+    }
+}
+
+
+StatScopeT::~StatScopeT() {
+    t_current = m_outer;
+}
+
+
+void statAlloc(std::size_t bytes) {
+    if (bytes == 0 || t_current < 0) {
+        return;
+    }
+    t_stats.api[t_current].allocations++;
+    t_stats.api[t_current].bytes += bytes;
+}
+
+#endif
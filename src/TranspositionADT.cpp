@@ -0,0 +1,154 @@
+/**
+ * \file TranspositionADT.cpp
+ * \author agent <agent@local>
+ */
+#include <algorithm>
+
+#include "Exceptions.h"
+#include "TranspositionADT.h"
+
+
+// Number of slots for a table holding `capacity` hashes: a power of two of at
+// least twice the capacity, keeping the load at most a half.
+static uint64_t slotCount(unsigned long capacity) {
+    if (capacity == 0) {
+        throw invalid_capacity();
+    }
+
+    uint64_t slots = 1;
+    while (slots < 2 * static_cast<uint64_t>(capacity)) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+
+// Slot value marking an empty slot. A real hash of 0 is stored as 1 instead;
+// the extra collision this causes is negligible.
+static const uint64_t EMPTY_SLOT = 0;
+
+
+static uint64_t slotKey(uint64_t h) {
+    return h == EMPTY_SLOT ? 1 : h;
+}
+
+
+TranspositionTableT::TranspositionTableT(unsigned long capacity) :
+    m_size(0)
+{
+    uint64_t slots = slotCount(capacity);
+    m_slots.assign(slots, EMPTY_SLOT);
+    m_mask = slots - 1;
+}
+
+
+InsertStatusT TranspositionTableT::insert(uint64_t h) {
+    h = slotKey(h);
+    for (uint64_t k = h & m_mask; ; k = (k + 1) & m_mask) {
+        if (m_slots[k] == h) {
+            return InsertDuplicate;
+        }
+        if (m_slots[k] == EMPTY_SLOT) {
+            if (m_size >= capacity()) {
+                return InsertFull;
+            }
+            m_slots[k] = h;
+            m_size++;
+            return InsertOk;
+        }
+    }
+}
+
+
+bool TranspositionTableT::contains(uint64_t h) const {
+    h = slotKey(h);
+    for (uint64_t k = h & m_mask; ; k = (k + 1) & m_mask) {
+        if (m_slots[k] == h) {
+            return true;
+        }
+        if (m_slots[k] == EMPTY_SLOT) {
+            return false;
+        }
+    }
+}
+
+
+unsigned long TranspositionTableT::size() const {
+    return m_size;
+}
+
+
+unsigned long TranspositionTableT::capacity() const {
+    return m_slots.size() / 2;
+}
+
+
+void TranspositionTableT::clear() {
+    std::fill(m_slots.begin(), m_slots.end(), EMPTY_SLOT);
+    m_size = 0;
+}
+
+
+ConcurrentTranspositionTableT::ConcurrentTranspositionTableT(unsigned long capacity) :
+    m_size(0)
+{
+    uint64_t slots = slotCount(capacity);
+    m_slots.reset(new std::atomic<uint64_t>[slots]);
+    m_mask = slots - 1;
+    clear();
+}
+
+
+InsertStatusT ConcurrentTranspositionTableT::insert(uint64_t h) {
+    h = slotKey(h);
+    for (uint64_t k = h & m_mask; ; k = (k + 1) & m_mask) {
+        uint64_t seen = m_slots[k].load(std::memory_order_relaxed);
+        if (seen == EMPTY_SLOT) {
+            // Reserve room first so that a full table fails cleanly.
+            if (m_size.fetch_add(1, std::memory_order_relaxed) >= capacity()) {
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+                return InsertFull;
+            }
+            if (m_slots[k].compare_exchange_strong(seen, h, std::memory_order_relaxed)) {
+                return InsertOk;
+            }
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            // Lost the slot to another thread; `seen` now holds its hash.
+        }
+        if (seen == h) {
+            return InsertDuplicate;
+        }
+    }
+}
+
+
+bool ConcurrentTranspositionTableT::contains(uint64_t h) const {
+    h = slotKey(h);
+    for (uint64_t k = h & m_mask; ; k = (k + 1) & m_mask) {
+        uint64_t seen = m_slots[k].load(std::memory_order_relaxed);
+        if (seen == h) {
+            return true;
+        }
+        if (seen == EMPTY_SLOT) {
+            return false;
+        }
+    }
+}
+
+
+unsigned long ConcurrentTranspositionTableT::size() const {
+    return m_size.load();
+}
+
+
+unsigned long ConcurrentTranspositionTableT::capacity() const {
+    return (m_mask + 1) / 2;
+}
+
+
+void ConcurrentTranspositionTableT::clear() {
+    for (uint64_t k = 0; k <= m_mask; k++) {
+        m_slots[k].store(EMPTY_SLOT, std::memory_order_relaxed);
+    }
+    m_size.store(0);
+}
@@ -0,0 +1,52 @@
+/**
+ * \file Zobrist.cpp
+ * \author agent <agent@local>
+ */
+#include "Zobrist.h"
+
+
+namespace {
+
+/**
+ * \brief The key tables, filled from a fixed seed so hashes are stable
+ *   across runs and processes.
+ */
+struct ZobristTables {
+    uint64_t keys[64][19];
+    uint64_t salts[32];
+
+    ZobristTables() {
+        uint64_t state = 0x5eed5eed5eed5eedULL;
+        for (int c = 0; c < 64; c++) {
+            for (int d = 0; d < 19; d++) {
+                keys[c][d] = next(state);
+            }
+        }
+        for (int k = 0; k < 32; k++) {
+            salts[k] = next(state);
+        }
+    }
+
+    // splitmix64
+    static uint64_t next(uint64_t & state) {
+        state += 0x9e3779b97f4a7c15ULL;
+        return zobristMix(state);
+    }
+};
+
+const ZobristTables & tables() {
+    static const ZobristTables t;
+    return t;
+}
+
+}
+
+
+uint64_t zobristKey(CardCodeT c, unsigned int depth) {
+    return tables().keys[c][depth];
+}
+
+
+uint64_t zobristSalt(unsigned int k) {
+    return tables().salts[k];
+}
@@ -0,0 +1,129 @@
+#include "catch.h"
+
+#include <vector>
+
+#include "BatchGameADT.h"
+#include "CardADT.h"
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "MoveADT.h"
+#include "StackADT.h"
+
+
+std::array<Stack<CardT>, 16> makeGameWon();
+
+
+// Steps a batch of boards of variant V and the same games in lockstep for
+// `n` moves, checking the batch's queries against BasicGameT after each
+// move. Board 0 sits out every other move.
+template <class V>
+static void playInLockstep(uint64_t seed, unsigned int n) {
+    typedef BasicGameT<V> G;
+    const unsigned int boards = 6;
+    BasicBatchGameT<V> batch(boards);
+    std::vector<G> games;
+    for (unsigned int b = 0; b < boards; b++) {
+        games.push_back(G(seed + b));
+        batch.load(b, games[b]);
+    }
+
+    std::vector<uint32_t> masks;
+    std::vector<unsigned char> won;
+    std::vector<FoundationHeightsT> heights;
+    std::vector<unsigned char> counts;
+    std::vector<MoveT> moves(boards);
+    typename G::MoveBufferT buffer;
+    for (unsigned int k = 0; k < n; k++) {
+        batch.moveMasks(masks);
+        batch.hasWon(won);
+        batch.foundationHeights(heights);
+        batch.homeCounts(counts);
+        for (unsigned int b = 0; b < boards; b++) {
+            REQUIRE(won[b] == games[b].hasWon());
+            REQUIRE(heights[b] == games[b].foundationHeights());
+            REQUIRE(counts[b] == games[b].homeCount());
+            for (unsigned int s = 0; s < G::Columns; s++) {
+                for (unsigned int d = 0; d < G::Columns; d++) {
+                    bool valid = games[b].checkMove(MoveT(s, d)) == MoveOk;
+                    REQUIRE(((masks[s * boards + b] >> d) & 1) == valid);
+                }
+            }
+
+            games[b].generateMoves(buffer, true);
+            if (buffer.isEmpty() || (b == 0 && k % 2 == 1)) {
+                moves[b] = MoveT(0, 0, 0);
+            } else {
+                moves[b] = buffer[(k * 7 + b) % buffer.size()];
+                games[b].applyTrusted(moves[b]);
+            }
+        }
+
+        batch.applyMoves(moves);
+        for (unsigned int b = 0; b < boards; b++) {
+            REQUIRE(batch.board(b).hash() == games[b].hash());
+        }
+    }
+}
+
+
+TEST_CASE("tests for BatchGameT", "[BatchGameT]") {
+
+    SECTION("boards round trip") {
+        BatchGameT batch(3);
+        REQUIRE(batch.size() == 3);
+        const GameT g(1);
+        batch.fill(g);
+        batch.load(1, GameT(2));
+        REQUIRE(batch.board(0).hash() == g.hash());
+        REQUIRE(batch.board(1).hash() == GameT(2).hash());
+        REQUIRE(batch.board(2).hash() == g.hash());
+        REQUIRE(batch.top(0, 3) == g.getCol(Cascade, 3).peek().code());
+        REQUIRE(batch.top(0, GameT::column(Cell, 0)) == 0);
+        REQUIRE_THROWS_AS(batch.load(3, g), invalid_placement);
+        REQUIRE_THROWS_AS(batch.board(3), invalid_placement);
+    }
+
+
+    SECTION("won boards") {
+        BatchGameT batch(2);
+        batch.load(0, GameT(makeGameWon()));
+        batch.load(1, GameT(1));
+        std::vector<unsigned char> won;
+        batch.hasWon(won);
+        REQUIRE(won.size() == 2);
+        REQUIRE(won[0] == 1);
+        REQUIRE(won[1] == 0);
+
+        std::vector<FoundationHeightsT> heights;
+        batch.foundationHeights(heights);
+        REQUIRE(heights[0] == 0x0D0D0D0Du);
+        REQUIRE(heights[1] == 0);
+        std::vector<unsigned char> counts;
+        batch.homeCounts(counts);
+        REQUIRE(counts[0] == 52);
+        REQUIRE(counts[1] == 0);
+
+        std::vector<uint32_t> masks;
+        batch.moveMasks(masks);
+        REQUIRE(masks.size() == GameT::Columns * 2);
+        // The Kings on the foundations can only go to a cell or a cascade.
+        REQUIRE(masks[GameT::column(Foundation, 0) * 2] == 0x0FFF);
+        REQUIRE(masks[0] == 0);
+    }
+
+
+    SECTION("applyMoves needs a move per board") {
+        BatchGameT batch(2);
+        REQUIRE_THROWS_AS(batch.applyMoves(std::vector<MoveT>(3)), invalid_move);
+    }
+
+
+    SECTION("masks and moves agree with GameT") {
+        playInLockstep<FreeCell>(1, 60);
+        playInLockstep<BakersGame>(10, 40);
+        playInLockstep<Seahaven>(20, 40);
+        playInLockstep<EightOff>(30, 40);
+    }
+
+}
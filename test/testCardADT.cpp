@@ -29,3 +29,31 @@ TEST_CASE("tests for CardT", "[CardT]") {
     }
 
 }
+
+
+TEST_CASE("tests for CardCodeT", "[CardT]") {
+
+    SECTION("code round trips through CardT") {
+        for (int s = Spades; s <= Diamonds; s++) {
+            for (RankT r = Ace; r <= King; r++) {
+                CardT c(static_cast<SuitT>(s), r);
+                CardT d(c.code());
+                REQUIRE(d.suit() == s);
+                REQUIRE(d.rank() == r);
+                REQUIRE(d.isRed() == (s == Hearts || s == Diamonds));
+            }
+        }
+    }
+
+
+    SECTION("card fits in a single byte") {
+        REQUIRE(sizeof(CardT) == 1);
+    }
+
+
+    SECTION("consecutive ranks of a suit have consecutive codes") {
+        REQUIRE(packCard(Clubs, 2) == packCard(Clubs, Ace) + 1);
+        REQUIRE(packCard(Hearts, King) == packCard(Hearts, Queen) + 1);
+    }
+
+}
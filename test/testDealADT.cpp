@@ -0,0 +1,141 @@
+#include "catch.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "CardADT.h"
+#include "DealADT.h"
+#include "Exceptions.h"
+
+
+// Formats a card as in the usual FreeCell listings, e.g. "TD" for the ten of
+// diamonds.
+static std::string name(CardCodeT c) {
+    std::string s;
+    s += "A23456789TJQK"[codeRank(c) - 1];
+    s += "SCHD"[codeSuit(c)];
+    return s;
+}
+
+
+static std::string row(const DeckT & d, int r) {
+    std::string s;
+    for (int k = r * 8; k < r * 8 + 8 && k < 52; k++) {
+        s += (s.empty() ? "" : " ") + name(d[k]);
+    }
+    return s;
+}
+
+
+static bool isPermutation(const DeckT & d) {
+    std::set<CardCodeT> seen(d.begin(), d.end());
+    for (CardCodeT c : d) {
+        if (codeRank(c) < Ace || codeRank(c) > King) {
+            return false;
+        }
+    }
+    return seen.size() == 52;
+}
+
+
+TEST_CASE("tests for microsoftDeck", "[Deal]") {
+
+    SECTION("deal 1 matches Microsoft FreeCell") {
+        DeckT d = microsoftDeck(1);
+        REQUIRE(row(d, 0) == "JD 2D 9H JC 5D 7H 7C 5H");
+        REQUIRE(row(d, 1) == "KD KC 9S 5S AD QC KH 3H");
+        REQUIRE(row(d, 6) == "6S 9C 2H 6H");
+    }
+
+
+    SECTION("deal 617 matches Microsoft FreeCell") {
+        DeckT d = microsoftDeck(617);
+        REQUIRE(row(d, 0) == "7D AD 5C 3S 5S 8C 2D AH");
+        REQUIRE(row(d, 6) == "JD KS KC 4H");
+    }
+
+
+    SECTION("every deal is a permutation of the deck") {
+        for (uint32_t n = 1; n <= 100; n++) {
+            REQUIRE(isPermutation(microsoftDeck(n)));
+        }
+    }
+
+}
+
+
+TEST_CASE("tests for fastDeck", "[Deal]") {
+
+    SECTION("every deal is a permutation of the deck") {
+        for (uint64_t n = 0; n < 100; n++) {
+            REQUIRE(isPermutation(fastDeck(n * 0x123456789ULL)));
+        }
+    }
+
+
+    SECTION("deals are reproducible and depend on the seed") {
+        REQUIRE(fastDeck(42) == fastDeck(42));
+        REQUIRE(fastDeck(42) != fastDeck(43));
+    }
+
+}
+
+
+TEST_CASE("tests for fastDoubleDeck", "[Deal]") {
+
+    SECTION("every deal holds each card twice") {
+        for (uint64_t n = 0; n < 100; n++) {
+            DoubleDeckT d = fastDoubleDeck(n * 0x123456789ULL);
+            std::map<CardCodeT, int> counts;
+            for (CardCodeT c : d) {
+                REQUIRE(codeRank(c) >= Ace);
+                REQUIRE(codeRank(c) <= King);
+                counts[c]++;
+            }
+            REQUIRE(counts.size() == 52);
+            for (const std::pair<const CardCodeT, int> &kv : counts) {
+                REQUIRE(kv.second == 2);
+            }
+        }
+    }
+
+
+    SECTION("deals are reproducible and depend on the seed") {
+        REQUIRE(fastDoubleDeck(42) == fastDoubleDeck(42));
+        REQUIRE(fastDoubleDeck(42) != fastDoubleDeck(43));
+    }
+
+}
+
+
+TEST_CASE("tests for DealArenaT", "[Deal]") {
+
+    SECTION("fast deals match fastDeck") {
+        DealArenaT a(21);
+        a.dealFast(1000, 21);
+        REQUIRE(a.size() == 21);
+        for (unsigned long k = 0; k < a.size(); k++) {
+            REQUIRE(a.seed(k) == 1000 + k);
+            REQUIRE(a.deck(k) == fastDeck(1000 + k));
+        }
+    }
+
+
+    SECTION("microsoft deals match microsoftDeck") {
+        DealArenaT a(4);
+        a.dealMicrosoft(1, 3);
+        REQUIRE(a.size() == 3);
+        REQUIRE(a.capacity() == 4);
+        REQUIRE(a.deck(0) == microsoftDeck(1));
+        REQUIRE(a.deck(2) == microsoftDeck(3));
+    }
+
+
+    SECTION("dealing more than the capacity throws full") {
+        DealArenaT a(4);
+        REQUIRE_THROWS_AS(a.dealFast(0, 5), full);
+        REQUIRE_THROWS_AS(a.dealMicrosoft(1, 5), full);
+    }
+
+}
@@ -0,0 +1,190 @@
+#include "catch.h"
+
+#include <vector>
+
+#include "CardADT.h"
+#include "DealADT.h"
+#include "Exceptions.h"
+#include "FortyThievesADT.h"
+#include "GameTypes.h"
+
+
+// A deal won by playing to the foundations whenever possible and dealing
+// otherwise: piles 0-7 hold Ace to 4 of one suit with the Ace on top, piles
+// 8 and 9 hold the fives, and the stock deals the sixes, then the sevens
+// and so on.
+static DoubleDeckT makeDeckSorted() {
+    DoubleDeckT d;
+    for (unsigned int r = 0; r < 4; r++) {
+        for (unsigned int p = 0; p < 8; p++) {
+            d[r * 10 + p] = packCard(static_cast<SuitT>(p % 4), 4 - r);
+        }
+        d[r * 10 + 8] = packCard(static_cast<SuitT>(r), 5);
+        d[r * 10 + 9] = packCard(static_cast<SuitT>(r), 5);
+    }
+
+    unsigned int k = 103;
+    for (RankT r = 6; r <= King; r++) {
+        for (unsigned int copy = 0; copy < 8; copy++) {
+            d[k--] = packCard(static_cast<SuitT>(copy % 4), r);
+        }
+    }
+    return d;
+}
+
+
+TEST_CASE("tests for FortyThievesT", "[FortyThieves]") {
+
+    SECTION("deal puts 4 cards on each pile and the rest in the stock") {
+        DoubleDeckT deck = fastDoubleDeck(7);
+        FortyThievesT g(deck);
+        for (unsigned int i = 0; i < 10; i++) {
+            REQUIRE(g.pile(i).size() == 4);
+            REQUIRE(g.pile(i).peek().code() == deck[30 + i]);
+        }
+        REQUIRE(g.stock().size() == 64);
+        REQUIRE(g.stock().peek().code() == deck[103]);
+        REQUIRE(g.waste().isEmpty());
+        for (unsigned int f = 0; f < 8; f++) {
+            REQUIRE(g.foundationHeight(f) == 0);
+        }
+        REQUIRE(g.hash() == FortyThievesT(7).hash());
+        REQUIRE(g.hash() != FortyThievesT(8).hash());
+    }
+
+
+    SECTION("moves follow the rules") {
+        FortyThievesT g(makeDeckSorted());
+        REQUIRE(g.checkMove(MoveT(0, FortyFoundation + Spades)) == MoveOk);
+        REQUIRE(g.checkMove(MoveT(0, FortyFoundation + Clubs)) == MoveInvalid);
+        REQUIRE(g.checkMove(MoveT(8, FortyFoundation + Hearts)) == MoveInvalid);
+        REQUIRE(g.checkMove(MoveT(0, 4)) == MoveInvalid);
+        REQUIRE(g.checkMove(MoveT(0, 0)) == MoveInvalid);
+        REQUIRE(g.checkMove(MoveT(FortyWaste, 0)) == MoveEmptySource);
+        REQUIRE(g.checkMove(MoveT(FortyStock, FortyWaste)) == MoveOk);
+        REQUIRE(g.checkMove(MoveT(FortyStock, 0)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(0, FortyStock)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(FortyFoundation, 0)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(0, FortyFoundation + Spades, 2)) == MoveInvalid);
+        REQUIRE(g.checkMove(MoveT(0, FortyFoundation + 4)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(0, 20)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(0, 31)) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(MoveT(FortyStock, FortyWaste, 5)) == MoveInvalid);
+        REQUIRE_THROWS_AS(g.performMove(MoveT(0, 20)), invalid_placement);
+        REQUIRE_THROWS_AS(g.performMove(MoveT(FortyStock, FortyWaste, 5)), invalid_move);
+        REQUIRE(g.stock().size() == 64);
+
+        g.performMove(MoveT(0, FortyFoundation + Spades));
+        g.performMove(MoveT(4, FortyFoundation + Spades));
+        REQUIRE(g.foundationHeight(0) == 1);
+        REQUIRE(g.foundationHeight(1) == 1);
+        g.performMove(MoveT(4, FortyFoundation + Spades));
+        REQUIRE(g.foundationHeight(0) == 2);
+        REQUIRE(g.foundationHeight(1) == 1);
+
+        // The Ace of hearts on pile 2 can go on the two of hearts on pile 6.
+        g.performMove(MoveT(6, FortyFoundation + Hearts));
+        REQUIRE(g.checkMove(MoveT(2, 6)) == MoveOk);
+        REQUIRE_THROWS_AS(g.performMove(MoveT(2, 5)), invalid_move);
+        REQUIRE_THROWS_AS(g.performMove(MoveT(FortyWaste, 5)), empty_source);
+        REQUIRE_THROWS_AS(g.performMove(MoveT(FortyStock, 1)), invalid_placement);
+        REQUIRE_THROWS_AS(g.pile(10), invalid_placement);
+        REQUIRE_THROWS_AS(g.foundationHeight(8), invalid_placement);
+    }
+
+
+    SECTION("generated moves are all valid") {
+        FortyThievesT g(12345);
+        MoveBuffer moves;
+        for (int k = 0; k < 200; k++) {
+            g.generateMoves(moves);
+            if (moves.isEmpty()) {
+                REQUIRE(g.noValidMoves());
+                break;
+            }
+            for (MoveT m : moves) {
+                REQUIRE(g.checkMove(m) == MoveOk);
+            }
+            g.applyTrusted(moves[k % moves.size()]);
+        }
+    }
+
+
+    SECTION("undo and redo restore the board") {
+        FortyThievesT g(99);
+        g.setJournaling(true);
+        uint64_t start = g.hash();
+        MoveBuffer moves;
+        std::vector<uint64_t> hashes;
+        for (int k = 0; k < 150; k++) {
+            g.generateMoves(moves);
+            if (moves.isEmpty()) {
+                break;
+            }
+            hashes.push_back(g.hash());
+            g.applyTrusted(moves[(k * 7) % moves.size()]);
+        }
+        uint64_t end = g.hash();
+
+        while (g.undoCount() > 0) {
+            g.undoMove();
+            REQUIRE(g.hash() == hashes[g.undoCount()]);
+        }
+        REQUIRE(g.hash() == start);
+        REQUIRE_THROWS_AS(g.undoMove(), empty_history);
+
+        REQUIRE(g.redoCount() == hashes.size());
+        for (unsigned int k = 0; k < hashes.size(); k++) {
+            g.redoMove();
+        }
+        REQUIRE(g.hash() == end);
+        REQUIRE_THROWS_AS(g.redoMove(), empty_history);
+    }
+
+
+    SECTION("playing to the foundations first wins a sorted deal") {
+        FortyThievesT g(makeDeckSorted());
+        g.setJournaling(true);
+        MoveBuffer moves;
+        while (!g.hasWon()) {
+            g.generateMoves(moves);
+            REQUIRE(!moves.isEmpty());
+            g.performMove(moves[0]);
+        }
+        REQUIRE(g.undoCount() == 104 + 64);
+        REQUIRE(g.noValidMoves());
+    }
+
+
+    SECTION("the hash depends only on the board") {
+        // Both Aces of spades go up and a card is dealt, in two orders.
+        FortyThievesT a(makeDeckSorted());
+        FortyThievesT b(makeDeckSorted());
+        uint64_t start = a.hash();
+        a.performMove(MoveT(0, FortyFoundation + Spades));
+        a.performMove(MoveT(4, FortyFoundation + Spades));
+        a.performMove(MoveT(FortyStock, FortyWaste));
+        b.performMove(MoveT(FortyStock, FortyWaste));
+        b.performMove(MoveT(4, FortyFoundation + Spades));
+        REQUIRE(a.hash() != b.hash());
+        b.performMove(MoveT(0, FortyFoundation + Spades));
+        REQUIRE(a.hash() == b.hash());
+        REQUIRE(a.hash() != start);
+    }
+
+
+    SECTION("moves are only journaled when asked") {
+        FortyThievesT g(5);
+        REQUIRE(!g.isJournaling());
+        g.performMove(MoveT(FortyStock, FortyWaste));
+        REQUIRE(g.undoCount() == 0);
+        REQUIRE_THROWS_AS(g.undoMove(), empty_history);
+
+        g.setJournaling(true);
+        g.performMove(MoveT(FortyStock, FortyWaste));
+        REQUIRE(g.undoCount() == 1);
+        g.setJournaling(false);
+        REQUIRE(g.undoCount() == 0);
+    }
+
+}
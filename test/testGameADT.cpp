@@ -6,6 +6,7 @@
 #include "GameTypes.h"
 #include "StackADT.h"
 #include <iostream>
+#include <type_traits>
 
 
 Stack<CardT> makeColumn(unsigned int capacity, int n, SuitT suits[], RankT ranks[]);
@@ -13,6 +14,16 @@ std::array<Stack<CardT>, 16> makeGame();
 std::array<Stack<CardT>, 16> makeGameNoMoves();
 std::array<Stack<CardT>, 16> makeGameEmptyCascade();
 std::array<Stack<CardT>, 16> makeGameWon();
+std::array<Stack<CardT>, 16> makeGameRun();
+std::array<Stack<CardT>, 16> makeGameAutoplay();
+
+
+// Reads a column through the const getCol, so that looking at a board does
+// not use the deprecated mutable overload.
+template <class V>
+static const ColumnT & readCol(const BasicGameT<V> & g, PlacementT p, unsigned int i) {
+    return g.getCol(p, i);
+}
 
 
 TEST_CASE("tests for GameT", "[GameT]") {
@@ -21,16 +32,47 @@ TEST_CASE("tests for GameT", "[GameT]") {
         GameT g;
         for (PlacementT p : { Cell, Foundation }) {
             for (int i = 0; i < 4; i++) {
-                REQUIRE(g.getCol(p, i).isEmpty());
-                REQUIRE(g.getCol(p, i).capacity() == (p == Cell ? 1 : 13));
+                REQUIRE(readCol(g, p, i).isEmpty());
+                REQUIRE(readCol(g, p, i).capacity() == (p == Cell ? 1 : 13));
             }
         }
 
         for (int i = 0; i < 8; i++) {
-            REQUIRE(!g.getCol(Cascade, i).isEmpty());
-            REQUIRE(g.getCol(Cascade, i).capacity() == 19);
-            REQUIRE(g.getCol(Cascade, i).seq().size() == (i < 4 ? 7 : 6));
+            REQUIRE(!readCol(g, Cascade, i).isEmpty());
+            REQUIRE(readCol(g, Cascade, i).capacity() == 19);
+            REQUIRE(readCol(g, Cascade, i).seq().size() == (i < 4 ? 7 : 6));
+        }
+    }
+
+
+    SECTION("seeded constructor deals reproducibly") {
+        GameT g(1);
+        REQUIRE(readCol(g, Cascade, 0).seq().size() == 7);
+        REQUIRE(readCol(g, Cascade, 7).seq().size() == 6);
+        // Microsoft deal 1 has the six of hearts on top of the 4th cascade.
+        REQUIRE(readCol(g, Cascade, 3).peek().suit() == Hearts);
+        REQUIRE(readCol(g, Cascade, 3).peek().rank() == 6);
+        REQUIRE(GameT(1).hash() == g.hash());
+        REQUIRE(GameT(2).hash() != g.hash());
+        REQUIRE(GameT(7, FastDeal).hash() == GameT(7, FastDeal).hash());
+        REQUIRE(GameT(7, FastDeal).hash() != GameT(7).hash());
+        REQUIRE(GameT(microsoftDeck(1)).hash() == g.hash());
+        // A seed is never taken for a board by accident.
+        REQUIRE(!std::is_convertible<uint64_t, GameT>::value);
+    }
+
+
+    SECTION("shuffled constructor deals every card once") {
+        GameT g;
+        unsigned long long seen = 0;
+        for (int i = 0; i < 8; i++) {
+            for (CardT c : readCol(g, Cascade, i).seq()) {
+                REQUIRE(c.rank() >= Ace);
+                REQUIRE(c.rank() <= King);
+                seen |= 1ULL << (c.suit() * 13 + c.rank() - 1);
+            }
         }
+        REQUIRE(seen == (1ULL << 52) - 1);
     }
 
 
@@ -187,6 +229,41 @@ TEST_CASE("tests for GameT", "[GameT]") {
     }
 
 
+    SECTION("generate moves matches is valid move") {
+        for (GameT g : { GameT(makeGame()), GameT(makeGameEmptyCascade()) }) {
+            MoveBuffer moves;
+            g.generateMoves(moves);
+            REQUIRE(!moves.isEmpty());
+
+            unsigned int n = 0;
+            for (unsigned int s = 0; s < 16; s++) {
+                if (readCol(g, GameT::placement(s), GameT::position(s)).isEmpty()) {
+                    continue;
+                }
+                for (unsigned int d = 0; d < 16; d++) {
+                    MoveT m(s, d);
+                    if (s == d || !g.isValidMove(GameT::placement(m.src()), GameT::position(m.src()), GameT::placement(m.dst()), GameT::position(m.dst()))) {
+                        continue;
+                    }
+                    REQUIRE(n < moves.size());
+                    REQUIRE(moves[n] == m);
+                    n++;
+                }
+            }
+            REQUIRE(n == moves.size());
+        }
+    }
+
+
+    SECTION("generate moves is empty when no move exists") {
+        GameT g(makeGameNoMoves());
+        MoveBuffer moves;
+        moves.push(MoveT(0, 1));
+        g.generateMoves(moves);
+        REQUIRE(moves.isEmpty());
+    }
+
+
     SECTION("perform move throws invalid placement") {
         GameT g(makeGame());
         REQUIRE_THROWS_AS(
@@ -213,44 +290,253 @@ TEST_CASE("tests for GameT", "[GameT]") {
     }
 
 
+    SECTION("check move reports the status of each exception") {
+        GameT g(makeGame());
+        REQUIRE(g.checkMove(Cascade, 8, Cascade, 0) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(Cascade, 0, Foundation, 4) == MoveInvalidPlacement);
+        REQUIRE(g.checkMove(Cell, 0, Foundation, 0) == MoveEmptySource);
+        REQUIRE(g.checkMove(Cascade, 0, Cascade, 0) == MoveInvalid);
+        REQUIRE(g.checkMove(Cascade, 1, Foundation, 0) == MoveOk);
+    }
+
+
+    SECTION("try move only changes state when the move is valid") {
+        GameT g(makeGame());
+        REQUIRE(g.tryMove(Cascade, 0, Cascade, 0) == MoveInvalid);
+        REQUIRE(readCol(g, Cascade, 0).seq().size() == 7);
+        REQUIRE(g.tryMove(Cell, 0, Cascade, 0) == MoveEmptySource);
+        REQUIRE(g.tryMove(Cascade, 1, Foundation, 0) == MoveOk);
+        REQUIRE(readCol(g, Cascade, 1).seq().size() == 6);
+        REQUIRE(readCol(g, Foundation, 0).peek().rank() == Ace);
+    }
+
+
     SECTION("perform move changes state correctly, moving to free cell when one is available") {
         GameT g(makeGame());
         g.performMove(Cascade, 1, Foundation, 0);
-        REQUIRE(g.getCol(Cascade, 1).seq().size() == 6);
-        REQUIRE(g.getCol(Foundation, 0).seq().size() == 1);
-        REQUIRE(g.getCol(Foundation, 0).peek().suit() == Clubs);
-        REQUIRE(g.getCol(Foundation, 0).peek().rank() == Ace);
-        REQUIRE(g.getCol(Cascade, 1).peek().suit() == Clubs);
-        REQUIRE(g.getCol(Cascade, 1).peek().rank() == 10);
+        REQUIRE(readCol(g, Cascade, 1).seq().size() == 6);
+        REQUIRE(readCol(g, Foundation, 0).seq().size() == 1);
+        REQUIRE(readCol(g, Foundation, 0).peek().suit() == Clubs);
+        REQUIRE(readCol(g, Foundation, 0).peek().rank() == Ace);
+        REQUIRE(readCol(g, Cascade, 1).peek().suit() == Clubs);
+        REQUIRE(readCol(g, Cascade, 1).peek().rank() == 10);
+    }
+
+
+    SECTION("undo move restores the previous state") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        std::vector<CardT> before = readCol(g, Cascade, 1).seq();
+        g.performMove(Cascade, 1, Foundation, 0);
+        g.performMove(Cascade, 3, Foundation, 0);
+        REQUIRE(g.undoCount() == 2);
+        g.undoMove();
+        REQUIRE(readCol(g, Foundation, 0).seq().size() == 1);
+        REQUIRE(readCol(g, Cascade, 3).peek().rank() == 2);
+        g.undoMove();
+        REQUIRE(readCol(g, Foundation, 0).isEmpty());
+        REQUIRE(readCol(g, Cascade, 1).seq().size() == before.size());
+        REQUIRE(readCol(g, Cascade, 1).peek().code() == before.back().code());
+        REQUIRE(g.undoCount() == 0);
+        REQUIRE(g.redoCount() == 2);
+    }
+
+
+    SECTION("redo move reapplies undone moves") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        g.performMove(Cascade, 1, Foundation, 0);
+        g.undoMove();
+        g.redoMove();
+        REQUIRE(readCol(g, Foundation, 0).peek().rank() == Ace);
+        REQUIRE(g.redoCount() == 0);
+        REQUIRE_THROWS_AS(g.redoMove(), empty_history);
+    }
+
+
+    SECTION("a new move discards undone moves") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        g.performMove(Cascade, 1, Foundation, 0);
+        g.undoMove();
+        g.performMove(Cascade, 0, Cell, 0);
+        REQUIRE(g.undoCount() == 1);
+        REQUIRE(g.redoCount() == 0);
+    }
+
+
+    SECTION("rewind undoes several moves") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        g.performMove(Cascade, 0, Cell, 0);
+        g.performMove(Cascade, 1, Foundation, 0);
+        g.performMove(Cascade, 2, Cell, 1);
+        REQUIRE_THROWS_AS(g.rewind(4), empty_history);
+        REQUIRE(g.undoCount() == 3);
+        g.rewind(3);
+        REQUIRE(readCol(g, Cell, 0).isEmpty());
+        REQUIRE(readCol(g, Cell, 1).isEmpty());
+        REQUIRE(readCol(g, Foundation, 0).isEmpty());
+        REQUIRE(readCol(g, Cascade, 2).seq().size() == 7);
+    }
+
+
+    SECTION("moves are only journaled when asked") {
+        GameT g(makeGame());
+        REQUIRE(!g.isJournaling());
+        g.performMove(Cascade, 1, Foundation, 0);
+        REQUIRE(g.undoCount() == 0);
+        REQUIRE_THROWS_AS(g.undoMove(), empty_history);
+
+        g.setJournaling(true);
+        g.performMove(Cascade, 3, Foundation, 0);
+        GameT copy(g);
+        REQUIRE(copy.isJournaling());
+        REQUIRE(copy.undoCount() == 1);
+        g.setJournaling(false);
+        REQUIRE(g.undoCount() == 0);
+        REQUIRE(g.hash() == copy.hash());
+    }
+
+
+    SECTION("undo move throws empty history") {
+        GameT g(makeGame());
+        REQUIRE_THROWS_AS(g.undoMove(), empty_history);
+        g.tryMove(Cascade, 0, Cascade, 0);
+        REQUIRE_THROWS_AS(g.undoMove(), empty_history);
+    }
+
+
+    SECTION("hash is maintained through moves and undo") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        uint64_t h = g.hash();
+        uint64_t ch = g.canonicalHash();
+        g.performMove(Cascade, 1, Foundation, 0);
+        g.performMove(Cascade, 0, Cell, 2);
+        REQUIRE(g.hash() != h);
+        REQUIRE(g.canonicalHash() != ch);
+
+        std::array<ColumnT, 16> cols;
+        for (unsigned int x = 0; x < 16; x++) {
+            cols[x] = readCol(g, GameT::placement(x), GameT::position(x));
+        }
+        GameT fresh(cols);
+        REQUIRE(fresh.hash() == g.hash());
+        REQUIRE(fresh.canonicalHash() == g.canonicalHash());
+
+        g.rewind(2);
+        REQUIRE(g.hash() == h);
+        REQUIRE(g.canonicalHash() == ch);
+    }
+
+
+    SECTION("editing a column directly keeps the hashes and masks in step") {
+        GameT g(makeGame());
+        g.setJournaling(true);
+        g.performMove(Cascade, 1, Foundation, 0);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        ColumnT &c0 = g.getCol(Cascade, 0);
+        ColumnT &cell = g.getCol(Cell, 3);
+#pragma GCC diagnostic pop
+        cell.push(c0.peek());
+        c0.pop();
+
+        std::array<ColumnT, 16> cols;
+        for (unsigned int x = 0; x < 16; x++) {
+            cols[x] = readCol(g, GameT::placement(x), GameT::position(x));
+        }
+        GameT fresh(cols);
+        REQUIRE(g.hash() == fresh.hash());
+        REQUIRE(g.canonicalHash() == fresh.canonicalHash());
+        REQUIRE(g.cellMask() == fresh.cellMask());
+        REQUIRE(g.topMask() == fresh.topMask());
+        REQUIRE(g.columnOf(cell.peek()) == GameT::column(Cell, 3));
+
+        // Moves after the edit start from the edited board.
+        g.performMove(Cell, 3, Cell, 0);
+        fresh.performMove(Cell, 3, Cell, 0);
+        REQUIRE(g.hash() == fresh.hash());
+        REQUIRE_THROWS_AS(readCol(g, Cell, 4), invalid_placement);
+    }
+
+
+    SECTION("canonical hash ignores the order of columns") {
+        std::array<Stack<CardT>, 16> a = makeGameEmptyCascade();
+        std::array<Stack<CardT>, 16> b = a;
+        std::swap(b[0], b[5]);
+        std::swap(b[8], b[11]);
+        std::swap(b[12], b[14]);
+        GameT g(a);
+        GameT h(b);
+        REQUIRE(g.hash() != h.hash());
+        REQUIRE(g.canonicalHash() == h.canonicalHash());
     }
 
 
     SECTION("get col returns correct column reference") {
         GameT g(makeGame());
         for (int i = 0; i < 8; i++) {
-            REQUIRE(g.getCol(Cascade, i).capacity() == 19);
+            REQUIRE(readCol(g, Cascade, i).capacity() == 19);
         }
         for (int i = 0; i < 4; i++) {
-            REQUIRE(g.getCol(Cell, i).capacity() == 1);
+            REQUIRE(readCol(g, Cell, i).capacity() == 1);
         }
         for (int i = 0; i < 4; i++) {
-            REQUIRE(g.getCol(Foundation, i).capacity() == 13);
+            REQUIRE(readCol(g, Foundation, i).capacity() == 13);
         }
     }
 
 
+    SECTION("columns keep the capacities they are given") {
+        std::array<Stack<CardT>, 16> cols = makeGame();
+        Stack<CardT> wide(40);
+        for (CardT c : cols[0].seq()) {
+            wide.push(c);
+        }
+        cols[0] = wide;
+        cols[11] = Stack<CardT>();
+        GameT g(cols);
+        REQUIRE(readCol(g, Cascade, 0).capacity() == ColumnBound);
+        REQUIRE(readCol(g, Cascade, 0).size() == wide.size());
+        REQUIRE(readCol(g, Cell, 3).capacity() == 0);
+
+        Stack<CardT> tall(40);
+        for (int k = 0; k < ColumnBound + 1; k++) {
+            tall.push(CardT(Spades, 1));
+        }
+        cols[0] = tall;
+        REQUIRE_THROWS_AS(GameT(cols), invalid_board);
+    }
+
+
+    SECTION("get col on a const game returns the same column") {
+        GameT g(makeGame());
+        const GameT & cg = g;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        REQUIRE(&cg.getCol(Cascade, 2) == &g.getCol(Cascade, 2));
+        REQUIRE(&cg.getCol(Cell, 1) == &g.getCol(Cell, 1));
+        REQUIRE(&cg.getCol(Foundation, 3) == &g.getCol(Foundation, 3));
+#pragma GCC diagnostic pop
+        REQUIRE(!cg.noValidMoves());
+        REQUIRE(cg.isValidMove(Cascade, 1, Foundation, 0));
+    }
+
+
     SECTION("get col throws invalid placement") {
         GameT g(makeGame());
         REQUIRE_THROWS_AS(
-            g.getCol(Cascade, 8),
+            readCol(g, Cascade, 8),
             invalid_placement
         );
         REQUIRE_THROWS_AS(
-            g.getCol(Cell, 4),
+            readCol(g, Cell, 4),
             invalid_placement
         );
         REQUIRE_THROWS_AS(
-            g.getCol(Foundation, 4),
+            readCol(g, Foundation, 4),
             invalid_placement
         );
 
@@ -259,6 +545,526 @@ TEST_CASE("tests for GameT", "[GameT]") {
 }
 
 
+TEST_CASE("tests for supermoves", "[GameT]") {
+
+    SECTION("run length and capacity") {
+        GameT g(makeGameRun());
+        REQUIRE(g.runLength(0) == 5);
+        REQUIRE(g.runLength(1) == 1);
+        REQUIRE(g.runLength(7) == 0);
+        REQUIRE_THROWS_AS(g.runLength(8), invalid_placement);
+        REQUIRE(g.supermoveCapacity(false) == 2);
+        REQUIRE(g.supermoveCapacity(true) == 1);
+
+        g.performMove(Cascade, 3, Cascade, 6);
+        REQUIRE(g.supermoveCapacity(false) == 4);
+        REQUIRE(g.supermoveCapacity(true) == 2);
+        g.performMove(Cell, 0, Cascade, 3);
+        REQUIRE(g.supermoveCapacity(false) == 4);
+        REQUIRE(g.supermoveCapacity(true) == 2);
+    }
+
+
+    SECTION("a supermove moves the run in order and undoes") {
+        GameT g(makeGameRun());
+        g.setJournaling(true);
+        uint64_t h = g.hash();
+        g.performMove(GameT::move(Cascade, 0, Cascade, 1, 2));
+        REQUIRE(readCol(g, Cascade, 0).size() == 4);
+        REQUIRE(readCol(g, Cascade, 1).size() == 4);
+        REQUIRE(readCol(g, Cascade, 1).peek().code() == packCard(Spades, 9));
+        REQUIRE(g.runLength(1) == 3);
+
+        std::array<ColumnT, 16> cols;
+        for (unsigned int x = 0; x < 16; x++) {
+            cols[x] = readCol(g, GameT::placement(x), GameT::position(x));
+        }
+        REQUIRE(GameT(cols).hash() == g.hash());
+
+        g.undoMove();
+        REQUIRE(g.hash() == h);
+        REQUIRE(g.runLength(0) == 5);
+        g.redoMove();
+        REQUIRE(g.hash() == GameT(cols).hash());
+    }
+
+
+    SECTION("invalid supermoves") {
+        GameT g(makeGameRun());
+        REQUIRE(g.checkMove(GameT::move(Cascade, 0, Cascade, 7, 2)) == MoveInvalid);
+        REQUIRE(g.checkMove(GameT::move(Cascade, 0, Cascade, 1, 3)) == MoveInvalid);
+        REQUIRE(g.checkMove(GameT::move(Cascade, 0, Cascade, 2, 6)) == MoveInvalid);
+        REQUIRE(g.checkMove(GameT::move(Cascade, 0, Cell, 0, 2)) == MoveInvalid);
+        REQUIRE(g.checkMove(GameT::move(Cascade, 0, Cascade, 1, 0)) == MoveInvalid);
+        REQUIRE(g.checkMove(GameT::move(Cascade, 7, Cascade, 1, 2)) == MoveEmptySource);
+        REQUIRE_THROWS_AS(g.performMove(GameT::move(Cascade, 0, Cascade, 1, 3)), invalid_move);
+        REQUIRE_THROWS_AS(g.performMove(GameT::move(Cascade, 7, Cascade, 1, 2)), empty_source);
+        REQUIRE(g.tryMove(GameT::move(Cascade, 0, Cascade, 7, 2)) == MoveInvalid);
+        REQUIRE(g.undoCount() == 0);
+    }
+
+
+    SECTION("generated supermoves are valid") {
+        GameT g(makeGameRun());
+        MoveBuffer moves;
+        g.generateMoves(moves);
+        for (MoveT m : moves) {
+            REQUIRE(m.count() == 1);
+        }
+
+        g.generateMoves(moves, true);
+        bool found = false;
+        for (MoveT m : moves) {
+            REQUIRE(g.checkMove(m) == MoveOk);
+            found = found || m == GameT::move(Cascade, 0, Cascade, 1, 2);
+        }
+        REQUIRE(found);
+
+        g.performMove(Cascade, 3, Cascade, 6);
+        g.generateMoves(moves, true);
+        unsigned int toEmpty = 0;
+        for (MoveT m : moves) {
+            REQUIRE(g.checkMove(m) == MoveOk);
+            if (m.count() > 1 && readCol(g, GameT::placement(m.dst()), GameT::position(m.dst())).isEmpty()) {
+                REQUIRE(m.count() <= g.supermoveCapacity(true));
+                toEmpty++;
+            }
+        }
+        REQUIRE(toEmpty == 4);
+    }
+
+}
+
+
+TEST_CASE("tests for autoplay", "[GameT]") {
+
+    SECTION("only safe cards are moved") {
+        GameT g(makeGameAutoplay());
+        REQUIRE(g.autoplay() == 2);
+        REQUIRE(readCol(g, Cascade, 0).size() == 1);
+        REQUIRE(readCol(g, Cascade, 1).isEmpty());
+        REQUIRE(readCol(g, Cascade, 2).isEmpty());
+        REQUIRE(readCol(g, Foundation, 0).peek().code() == packCard(Spades, 4));
+        REQUIRE(readCol(g, Foundation, 3).peek().code() == packCard(Diamonds, 3));
+        REQUIRE(g.autoplay() == 0);
+    }
+
+
+    SECTION("journaled autoplay is undone with the move before it") {
+        GameT g(makeGameWon());
+        g.setJournaling(true);
+        g.performMove(Foundation, 0, Cascade, 0);
+        g.performMove(Foundation, 2, Cell, 0);
+        g.performMove(Foundation, 0, Cascade, 1);
+        uint64_t h = g.hash();
+        REQUIRE(g.autoplay() == 3);
+        REQUIRE(g.hasWon());
+        REQUIRE(g.undoCount() == 3);
+
+        std::vector<MoveT> moves;
+        g.history(moves);
+        REQUIRE(moves.size() == 6);
+
+        g.undoMove();
+        REQUIRE(g.undoCount() == 2);
+        REQUIRE(g.redoCount() == 1);
+        REQUIRE(readCol(g, Cascade, 0).size() == 1);
+        REQUIRE(readCol(g, Cell, 0).size() == 1);
+        g.redoMove();
+        REQUIRE(g.hasWon());
+        g.undoMove();
+        g.redoMove();
+        REQUIRE(g.hasWon());
+        g.undoMove();
+        g.performMove(Foundation, 0, Cascade, 1);
+        REQUIRE(g.hash() == h);
+        REQUIRE(g.redoCount() == 0);
+    }
+
+
+    SECTION("autoplay keeps the history usable") {
+        GameT g(makeGameWon());
+        g.setJournaling(true);
+        uint64_t won = g.hash();
+        g.performMove(Foundation, 0, Cascade, 0);
+        g.performMove(Foundation, 1, Cell, 0);
+        REQUIRE(g.autoplay() == 2);
+        REQUIRE(g.hasWon());
+        REQUIRE(g.undoCount() == 2);
+
+        // The cards autoplay moved go back with the move they followed.
+        g.undoMove();
+        REQUIRE(readCol(g, Cascade, 0).size() == 1);
+        REQUIRE(readCol(g, Cell, 0).isEmpty());
+        g.redoMove();
+        REQUIRE(g.hasWon());
+        g.rewind(2);
+        REQUIRE(g.hash() == won);
+        REQUIRE(g.redoCount() == 2);
+
+        // Autoplay with no move before it is undone as a move of its own.
+        GameT a(makeGameWon());
+        a.performMove(Foundation, 0, Cascade, 0);
+        a.setJournaling(true);
+        REQUIRE(a.autoplay() == 1);
+        REQUIRE(a.undoCount() == 1);
+        a.undoMove();
+        REQUIRE(readCol(a, Cascade, 0).size() == 1);
+    }
+
+
+    SECTION("autoplay after every move") {
+        GameT g(makeGameAutoplay());
+        g.setJournaling(true);
+        g.setAutoplay(true);
+        uint64_t h = g.hash();
+        g.performMove(Cascade, 0, Cell, 0);
+        REQUIRE(readCol(g, Cascade, 2).isEmpty());
+        REQUIRE(g.undoCount() == 1);
+        g.undoMove();
+        REQUIRE(g.hash() == h);
+    }
+
+}
+
+
+// An empty board of variant G.
+template <class G>
+static std::array<ColumnT, G::Columns> makeEmptyBoard() {
+    std::array<ColumnT, G::Columns> cols;
+    for (unsigned int x = 0; x < G::Columns; x++) {
+        PlacementT p = G::placement(x);
+        cols[x] = ColumnT(p == Cascade ? G::CascadeCapacity : (p == Cell ? 1 : 13));
+    }
+    return cols;
+}
+
+
+// Whether the top card of board column `s` may move on to board column `d`
+// by the rules on the cards themselves, rather than the game's card masks.
+template <class V>
+static bool rulesAllow(const BasicGameT<V> & g, unsigned int s, unsigned int d) {
+    typedef BasicGameT<V> G;
+    PlacementT p = G::placement(s);
+    PlacementT q = G::placement(d);
+    const ColumnT &src = readCol(g, p, s - G::column(p, 0));
+    const ColumnT &dst = readCol(g, q, d - G::column(q, 0));
+    if (src.isEmpty() || s == d) {
+        return false;
+    }
+
+    CardCodeT c = src.peek().code();
+    CardCodeT t = dst.isEmpty() ? 0 : dst.peek().code();
+    switch (q) {
+        case Cell:
+            return dst.isEmpty();
+        case Foundation:
+            return p != Foundation && canBuild(c, dst.isEmpty(), t);
+        case Cascade:
+            return canStack<V>(c, dst.isEmpty(), t);
+    }
+    return false;
+}
+
+
+// Makes `n` generated moves, checking each is valid and that the single card
+// moves are exactly the pairs the rules allow, in order, then undoes them
+// all.
+template <class V>
+static void playAndUndo(BasicGameT<V> & g, unsigned int n) {
+    typedef BasicGameT<V> G;
+    g.setJournaling(true);
+    typename G::MoveBufferT moves;
+    uint64_t start = g.hash();
+    for (unsigned int k = 0; k < n; k++) {
+        g.generateMoves(moves, true);
+        if (moves.isEmpty()) {
+            break;
+        }
+        for (MoveT m : moves) {
+            REQUIRE(g.checkMove(m) == MoveOk);
+        }
+
+        unsigned int i = 0;
+        for (unsigned int s = 0; s < G::Columns; s++) {
+            for (unsigned int d = 0; d < G::Columns; d++) {
+                bool valid = g.checkMove(MoveT(s, d)) == MoveOk;
+                REQUIRE(valid == rulesAllow(g, s, d));
+                if (valid) {
+                    REQUIRE(i < moves.size());
+                    REQUIRE(moves[i++] == MoveT(s, d));
+                }
+            }
+        }
+        REQUIRE((i == moves.size() || moves[i].count() > 1));
+        g.applyTrusted(moves[(k * 5) % moves.size()]);
+    }
+    g.rewind(g.undoCount());
+    REQUIRE(g.hash() == start);
+}
+
+
+TEST_CASE("tests for variants", "[GameT]") {
+
+    SECTION("placement moves follow the variant's layout") {
+        EightOffT e(1);
+        MoveT m = EightOffT::move(Cascade, 0, Cell, 6);
+        REQUIRE(m.src() == 0);
+        REQUIRE(m.dst() == 14);
+        REQUIRE(EightOffT::move(Cell, 0, Foundation, 3).dst() == 19);
+        CardCodeT c = readCol(e, Cascade, 0).peek().code();
+        e.performMove(m);
+        REQUIRE(readCol(e, Cell, 6).peek().code() == c);
+
+        SeahavenT s(1);
+        MoveT n = SeahavenT::move(Cascade, 9, Cell, 3);
+        REQUIRE(n.src() == 9);
+        REQUIRE(n.dst() == 13);
+        REQUIRE(SeahavenT::move(Cell, 0, Foundation, 0).dst() == 14);
+        c = readCol(s, Cascade, 9).peek().code();
+        s.performMove(n);
+        REQUIRE(readCol(s, Cell, 3).peek().code() == c);
+
+        for (unsigned int x = 0; x < EightOffT::Columns; x++) {
+            REQUIRE(EightOffT::column(EightOffT::placement(x), EightOffT::position(x)) == x);
+        }
+        for (unsigned int x = 0; x < SeahavenT::Columns; x++) {
+            REQUIRE(SeahavenT::column(SeahavenT::placement(x), SeahavenT::position(x)) == x);
+        }
+        REQUIRE(EightOffT::placement(15) == Cell);
+        REQUIRE(SeahavenT::position(9) == 9);
+        REQUIRE(SeahavenT::position(15) == 1);
+    }
+
+
+    SECTION("deals follow the geometry") {
+        EightOffT e(1);
+        REQUIRE(EightOffT::Columns == 20);
+        for (unsigned int i = 0; i < 8; i++) {
+            REQUIRE(readCol(e, Cascade, i).size() == 6);
+            REQUIRE(readCol(e, Cell, i).size() == (i < 4 ? 1 : 0));
+        }
+        REQUIRE_THROWS_AS(readCol(e, Cell, 8), invalid_placement);
+
+        SeahavenT s(1);
+        REQUIRE(SeahavenT::Columns == 18);
+        for (unsigned int i = 0; i < 10; i++) {
+            REQUIRE(readCol(s, Cascade, i).size() == 5);
+            REQUIRE(readCol(s, Cascade, i).capacity() == 17);
+        }
+        REQUIRE(readCol(s, Cell, 1).size() == 1);
+        REQUIRE(readCol(s, Cell, 2).isEmpty());
+        REQUIRE_THROWS_AS(readCol(s, Cascade, 10), invalid_placement);
+
+        TwoCellGameT t(1);
+        REQUIRE(readCol(t, Cascade, 0).begin()->code() == readCol(GameT(1), Cascade, 0).begin()->code());
+        REQUIRE(t.supermoveCapacity(false) == 3);
+        REQUIRE_THROWS_AS(readCol(t, Cell, 2), invalid_placement);
+        REQUIRE(t.checkMove(MoveT(0, 16)) == MoveInvalidPlacement);
+    }
+
+
+    SECTION("building by suit") {
+        std::array<ColumnT, 16> cols = makeEmptyBoard<BakersGameT>();
+        cols[0].push(CardT(Spades, King));
+        cols[1].push(CardT(Spades, Queen));
+        cols[2].push(CardT(Hearts, Queen));
+        BakersGameT b(cols);
+        REQUIRE(b.isValidMove(Cascade, 1, Cascade, 0));
+        REQUIRE(!b.isValidMove(Cascade, 2, Cascade, 0));
+        GameT g(cols);
+        REQUIRE(!g.isValidMove(Cascade, 1, Cascade, 0));
+        REQUIRE(g.isValidMove(Cascade, 2, Cascade, 0));
+    }
+
+
+    SECTION("only Kings on empty cascades") {
+        std::array<ColumnT, 18> cols = makeEmptyBoard<SeahavenT>();
+        cols[0].push(CardT(Spades, Queen));
+        cols[1].push(CardT(Hearts, King));
+        cols[2].push(CardT(Hearts, King));
+        cols[2].push(CardT(Hearts, Queen));
+        SeahavenT s(cols);
+        REQUIRE(!s.isValidMove(Cascade, 0, Cascade, 3));
+        REQUIRE(s.isValidMove(Cascade, 1, Cascade, 3));
+        REQUIRE(s.isValidMove(Cascade, 0, Cell, 0));
+        REQUIRE(s.supermoveCapacity(true) == 5);
+        REQUIRE(s.checkMove(MoveT(2, 3, 2)) == MoveOk);
+        REQUIRE(s.checkMove(MoveT(2, 0, 2)) == MoveInvalid);
+    }
+
+
+    SECTION("suited foundation moves are always safe to autoplay") {
+        std::array<ColumnT, 16> cols = makeEmptyBoard<BakersGameT>();
+        for (RankT r = King; r >= 1; r--) {
+            cols[r % 8].push(CardT(Hearts, r));
+        }
+        BakersGameT b(cols);
+        REQUIRE(b.autoplay() == 13);
+        REQUIRE(readCol(b, Foundation, 0).size() == 13);
+    }
+
+
+    SECTION("generated moves are valid and undo restores every variant") {
+        GameT g(617);
+        playAndUndo(g, 60);
+        BakersGameT b(617);
+        playAndUndo(b, 60);
+        EightOffT e(617);
+        playAndUndo(e, 60);
+        SeahavenT s(617);
+        playAndUndo(s, 60);
+        TwoCellGameT t(617);
+        playAndUndo(t, 60);
+    }
+
+
+    SECTION("snapshots hold at most 16 columns") {
+        TwoCellGameT t(5);
+        TwoCellGameT u((SnapshotViewT(t.snapshot())));
+        REQUIRE(u.hash() == t.hash());
+        REQUIRE_THROWS_AS(EightOffT(5).snapshot(), invalid_board);
+    }
+
+}
+
+
+// Checks the card masks and card columns of `g` against its columns.
+template <class G>
+static void requireMasks(const G & g) {
+    CardMaskT tops = 0;
+    CardMaskT cells = 0;
+    for (unsigned int x = 0; x < G::Columns; x++) {
+        const ColumnT &col = readCol(g, G::placement(x), x - G::column(G::placement(x), 0));
+        for (CardT c : col) {
+            REQUIRE(g.columnOf(c) == x);
+        }
+        if (!col.isEmpty() && G::placement(x) == Cascade) {
+            tops |= cardBit(col.peek().code());
+        }
+        if (!col.isEmpty() && G::placement(x) == Cell) {
+            cells |= cardBit(col.peek().code());
+        }
+    }
+    REQUIRE(g.topMask() == tops);
+    REQUIRE(g.cellMask() == cells);
+}
+
+
+TEST_CASE("tests for card masks", "[GameT]") {
+
+    SECTION("masks of a new deal") {
+        GameT g(1);
+        requireMasks(g);
+        CardMaskT aces = 0;
+        for (unsigned int suit = 0; suit < 4; suit++) {
+            aces |= cardBit(packCard(static_cast<SuitT>(suit), Ace));
+        }
+        REQUIRE(g.foundationMask() == aces);
+        REQUIRE(g.cellMask() == 0);
+    }
+
+
+    SECTION("foundation mask follows the foundations") {
+        GameT g(makeGameAutoplay());
+        CardMaskT playable = (g.topMask() | g.cellMask()) & g.foundationMask();
+        REQUIRE(playable == (cardBit(packCard(Diamonds, 3)) | cardBit(packCard(Spades, 4)) |
+                             cardBit(packCard(Hearts, 5))));
+        g.autoplay();
+        REQUIRE((g.foundationMask() & cardBit(packCard(Spades, 5))) != 0);
+        REQUIRE((g.foundationMask() & cardBit(packCard(Diamonds, 4))) != 0);
+        requireMasks(g);
+    }
+
+
+    SECTION("stack targets find the accepting cascades") {
+        std::array<ColumnT, 16> cols = makeEmptyBoard<GameT>();
+        cols[2].push(CardT(Spades, 8));
+        cols[5].push(CardT(Clubs, 8));
+        cols[6].push(CardT(Hearts, 8));
+        cols[6].push(CardT(Diamonds, 9));
+        GameT g(cols);
+        CardMaskT targets = g.stackTargets(CardT(Hearts, 7));
+        REQUIRE(targets == (cardBit(packCard(Spades, 8)) | cardBit(packCard(Clubs, 8))));
+        REQUIRE(g.columnOf(CardT(Clubs, 8)) == 5);
+        REQUIRE(g.stackTargets(CardT(Spades, 7)) == 0);
+        REQUIRE(g.stackTargets(CardT(Spades, 8)) == cardBit(packCard(Diamonds, 9)));
+        REQUIRE(g.columnOf(CardT(Hearts, King)) == GameT::Columns);
+
+        BakersGameT b(cols);
+        REQUIRE(b.stackTargets(CardT(Spades, 7)) == cardBit(packCard(Spades, 8)));
+    }
+
+
+    SECTION("masks are maintained by moves, undo and redo") {
+        GameT g(617);
+        g.setJournaling(true);
+        SeahavenT s(617);
+        MoveBuffer moves;
+        SeahavenT::MoveBufferT smoves;
+        for (unsigned int k = 0; k < 80; k++) {
+            g.generateMoves(moves, true);
+            s.generateMoves(smoves, true);
+            if (!moves.isEmpty()) {
+                g.applyTrusted(moves[(k * 3) % moves.size()]);
+            }
+            if (!smoves.isEmpty()) {
+                s.applyTrusted(smoves[(k * 3) % smoves.size()]);
+            }
+            requireMasks(g);
+            requireMasks(s);
+        }
+        g.rewind(g.undoCount() / 2);
+        requireMasks(g);
+        g.redoMove();
+        requireMasks(g);
+    }
+
+}
+
+
+TEST_CASE("tests for foundation heights", "[GameT]") {
+
+    SECTION("packed heights") {
+        FoundationHeightsT h = 0x0D00030Bu;
+        REQUIRE(heightOf(h, Spades) == 11);
+        REQUIRE(heightOf(h, Clubs) == 3);
+        REQUIRE(heightOf(h, Hearts) == 0);
+        REQUIRE(heightOf(h, Diamonds) == 13);
+        REQUIRE(heightsTotal(h) == 27);
+        REQUIRE(heightsTotal(0x0D0D0D0Du) == 52);
+        REQUIRE(!heightsComplete(h));
+        REQUIRE(heightsComplete(0x0D0D0D0Du));
+    }
+
+
+    SECTION("heights follow the foundations") {
+        GameT g(1);
+        REQUIRE(g.foundationHeights() == 0);
+        REQUIRE(g.homeCount() == 0);
+
+        GameT a(makeGameAutoplay());
+        REQUIRE(a.foundationHeights() == 0x02040303u);
+        REQUIRE(a.homeCount() == 12);
+        a.autoplay();
+        REQUIRE(heightOf(a.foundationHeights(), Spades) == 4);
+        REQUIRE(heightOf(a.foundationHeights(), Diamonds) == 3);
+        REQUIRE(a.homeCount() == 14);
+
+        GameT w(makeGameWon());
+        w.setJournaling(true);
+        REQUIRE(w.homeCount() == 52);
+        REQUIRE(w.hasWon());
+        w.performMove(Foundation, 0, Cell, 0);
+        REQUIRE(w.homeCount() == 51);
+        REQUIRE(!w.hasWon());
+        w.undoMove();
+        REQUIRE(w.hasWon());
+    }
+
+}
+
+
 Stack<CardT> makeColumn(unsigned int capacity, std::vector<SuitT> suits, std::vector<RankT> ranks) {
     Stack<CardT> s(capacity);
     for (unsigned int i = 0; i < suits.size(); i++) {
@@ -410,3 +1216,58 @@ std::array<Stack<CardT>, 16> makeGameWon() {
 
     return arr;
 }
+
+
+// Cascade 0 ends in a run of five, KS down to 9S, which can move two cards
+// on to the JS of cascade 1. Every cell is full and only cascade 7 is empty.
+std::array<Stack<CardT>, 16> makeGameRun() {
+    std::array<Stack<CardT>, 16> arr;
+    arr[0] = makeColumn(19, { Diamonds, Spades, Hearts, Clubs, Diamonds, Spades },
+                            { 5, King, Queen, Jack, 10, 9 });
+    arr[1] = makeColumn(19, { Clubs, Spades }, { 2, Jack });
+    arr[2] = makeColumn(19, { Clubs }, { 3 });
+    arr[3] = makeColumn(19, { Clubs }, { 7 });
+    arr[4] = makeColumn(19, { Spades }, { 7 });
+    arr[5] = makeColumn(19, { Hearts }, { 7 });
+    arr[6] = makeColumn(19, { Diamonds }, { 8 });
+    arr[7] = Stack<CardT>(19);
+
+    arr[8] = makeColumn(1, { Clubs }, { 4 });
+    arr[9] = makeColumn(1, { Spades }, { 4 });
+    arr[10] = makeColumn(1, { Hearts }, { 4 });
+    arr[11] = makeColumn(1, { Diamonds }, { 6 });
+
+    for (int i = 12; i < 16; i++) {
+        arr[i] = Stack<CardT>(13);
+    }
+
+    return arr;
+}
+
+
+// Foundations hold spades and clubs to 3, hearts to 4 and diamonds to 2.
+// The 3D on cascade 2 is safe, which makes the 4S on cascade 1 safe, but the
+// 5H on cascade 0 is not while the clubs are at 3.
+std::array<Stack<CardT>, 16> makeGameAutoplay() {
+    std::array<Stack<CardT>, 16> arr;
+    for (int i = 0; i < 8; i++) {
+        arr[i] = Stack<CardT>(19);
+    }
+    arr[0].push(CardT(Hearts, 5));
+    arr[1].push(CardT(Spades, 4));
+    arr[2].push(CardT(Diamonds, 3));
+
+    for (int i = 8; i < 12; i++) {
+        arr[i] = Stack<CardT>(1);
+    }
+
+    RankT tops[4] = { 3, 3, 4, 2 };
+    for (int i = 0; i < 4; i++) {
+        arr[i + 12] = Stack<CardT>(13);
+        for (RankT r = Ace; r <= tops[i]; r++) {
+            arr[i + 12].push(CardT(static_cast<SuitT>(i), r));
+        }
+    }
+
+    return arr;
+}
@@ -0,0 +1,77 @@
+#include "catch.h"
+
+#include <vector>
+
+#include "Exceptions.h"
+#include "JournalADT.h"
+#include "MoveADT.h"
+
+
+static JournalEntryT entry(unsigned int s, unsigned int d, bool automatic) {
+    JournalEntryT e;
+    e.src = static_cast<unsigned char>(s);
+    e.dst = static_cast<unsigned char>(d);
+    e.card = 0;
+    e.count = 1;
+    e.automatic = automatic;
+    return e;
+}
+
+
+TEST_CASE("tests for JournalT", "[JournalT]") {
+
+    SECTION("records nothing until enabled") {
+        JournalT j;
+        REQUIRE(!j.isEnabled());
+        j.record(entry(0, 1, false));
+        REQUIRE(j.applied() == 0);
+        REQUIRE_THROWS_AS(j.undo(), empty_history);
+
+        j.setEnabled(true);
+        j.record(entry(0, 1, false));
+        REQUIRE(j.applied() == 1);
+        j.setEnabled(false);
+        REQUIRE(j.applied() == 0);
+    }
+
+
+    SECTION("automatic entries are undone and redone with their move") {
+        JournalT j;
+        j.setEnabled(true);
+        j.record(entry(0, 1, false));
+        j.record(entry(2, 3, false));
+        j.record(entry(4, 12, true));
+        j.record(entry(5, 12, true));
+        REQUIRE(j.undoCount() == 2);
+
+        REQUIRE(j.undo() == 3);
+        REQUIRE(j.applied() == 1);
+        REQUIRE(j[1].src == 2);
+        REQUIRE(j.undoCount() == 1);
+        REQUIRE(j.redoCount() == 1);
+
+        REQUIRE(j.redo() == 3);
+        REQUIRE(j.applied() == 4);
+        REQUIRE_THROWS_AS(j.redo(), empty_history);
+
+        std::vector<MoveT> moves;
+        j.history(moves);
+        REQUIRE(moves.size() == 4);
+        REQUIRE(moves[3] == MoveT(5, 12));
+    }
+
+
+    SECTION("a new move discards the undone ones") {
+        JournalT j;
+        j.setEnabled(true);
+        j.record(entry(0, 1, false));
+        j.record(entry(2, 3, false));
+        j.undo();
+        j.undo();
+        j.record(entry(4, 5, false));
+        REQUIRE(j.undoCount() == 1);
+        REQUIRE(j.redoCount() == 0);
+        REQUIRE(j[0].src == 4);
+    }
+
+}
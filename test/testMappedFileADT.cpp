@@ -0,0 +1,54 @@
+#include "catch.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "Exceptions.h"
+#include "MappedFileADT.h"
+
+
+static const char MAGIC[4] = { 'T', 'E', 'S', 'T' };
+
+
+static void writeFile(const char * path, const char * bytes, unsigned long n) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes, n);
+}
+
+
+TEST_CASE("tests for MappedFileT", "[MappedFile]") {
+    const char * path = "bin/testMappedFile.bin";
+
+    SECTION("files starting with the magic are mapped whole") {
+        writeFile(path, "TESTdata", 8);
+        {
+            MappedFileT f(path, MAGIC, sizeof(MAGIC));
+            REQUIRE(f.size() == 8);
+            REQUIRE(f.data()[4] == 'd');
+            REQUIRE(f.data()[7] == 'a');
+        }
+        std::remove(path);
+    }
+
+
+    SECTION("files with the wrong magic throw io error") {
+        writeFile(path, "TOSTdata", 8);
+        REQUIRE_THROWS_AS(MappedFileT(path, MAGIC, sizeof(MAGIC)), io_error);
+        std::remove(path);
+    }
+
+
+    SECTION("files shorter than required throw io error") {
+        writeFile(path, "TES", 3);
+        REQUIRE_THROWS_AS(MappedFileT(path, MAGIC, sizeof(MAGIC)), io_error);
+        writeFile(path, "TESTdata", 8);
+        REQUIRE_THROWS_AS(MappedFileT(path, MAGIC, sizeof(MAGIC), 9), io_error);
+        std::remove(path);
+    }
+
+
+    SECTION("missing files throw io error") {
+        REQUIRE_THROWS_AS(MappedFileT("bin/no such file", MAGIC, sizeof(MAGIC)), io_error);
+    }
+
+}
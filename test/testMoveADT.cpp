@@ -0,0 +1,55 @@
+#include "catch.h"
+
+#include "GameTypes.h"
+#include "MoveADT.h"
+
+
+TEST_CASE("tests for MoveT", "[MoveT]") {
+
+    SECTION("move fits in two bytes") {
+        REQUIRE(sizeof(MoveT) == 2);
+    }
+
+
+    SECTION("columns up to 31 and runs up to 13 round trip") {
+        for (unsigned int s = 0; s < 32; s++) {
+            for (unsigned int n = 1; n <= 13; n++) {
+                MoveT m(s, 31 - s, n);
+                REQUIRE(m.src() == s);
+                REQUIRE(m.dst() == 31 - s);
+                REQUIRE(m.count() == n);
+            }
+        }
+        REQUIRE(!(MoveT(1, 2, 2) == MoveT(1, 2)));
+    }
+
+}
+
+
+TEST_CASE("tests for MoveBuffer", "[MoveT]") {
+
+    SECTION("push, index and clear") {
+        MoveBuffer b;
+        REQUIRE(b.isEmpty());
+        b.push(MoveT(0, 8));
+        b.push(MoveT(1, 2));
+        REQUIRE(b.size() == 2);
+        REQUIRE(b[1] == MoveT(1, 2));
+        REQUIRE(b.end() - b.begin() == 2);
+        b.clear();
+        REQUIRE(b.isEmpty());
+    }
+
+
+    SECTION("pushAll appends a move per destination, lowest first") {
+        MoveBuffer b;
+        b.push(MoveT(0, 1));
+        b.pushAll(3, (1u << 0) | (1u << 5) | (1u << 31));
+        b.pushAll(4, 0);
+        REQUIRE(b.size() == 4);
+        REQUIRE(b[1] == MoveT(3, 0));
+        REQUIRE(b[2] == MoveT(3, 5));
+        REQUIRE(b[3] == MoveT(3, 31));
+    }
+
+}
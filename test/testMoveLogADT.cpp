@@ -0,0 +1,213 @@
+#include "catch.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "MoveLogADT.h"
+
+
+// Plays `n` moves of deal `seed`, always taking the last generated move.
+static std::vector<MoveT> playDeal(uint64_t seed, unsigned int n) {
+    GameT g(seed);
+    MoveBuffer moves;
+    std::vector<MoveT> played;
+    for (unsigned int k = 0; k < n; k++) {
+        g.generateMoves(moves);
+        if (moves.isEmpty()) {
+            break;
+        }
+        played.push_back(moves[moves.size() - 1]);
+        g.applyTrusted(played.back());
+    }
+    return played;
+}
+
+
+TEST_CASE("tests for move packing", "[MoveLog]") {
+
+    SECTION("every move round trips") {
+        for (unsigned int s = 0; s < 16; s++) {
+            for (unsigned int d = 0; d < 16; d++) {
+                if (s == d) {
+                    continue;
+                }
+                for (unsigned int n = 1; n <= 13; n++) {
+                    MoveT m(s, d, n);
+                    unsigned char packed[2];
+                    unsigned int bytes = packMove(m, packed);
+                    REQUIRE(bytes == (n == 1 ? 1u : 2u));
+                    REQUIRE(isEscape(packed[0]) == (n > 1));
+
+                    MoveT u;
+                    REQUIRE(unpackMove(packed, packed + bytes, u) == bytes);
+                    REQUIRE(u == m);
+                }
+            }
+        }
+    }
+
+
+    SECTION("malformed escapes do not unpack") {
+        unsigned char packed[] = { 0x33, 0x55 };
+        MoveT u;
+        REQUIRE(unpackMove(packed, packed + 1, u) == 0);
+        REQUIRE(unpackMove(packed, packed + 2, u) == 0);
+        REQUIRE(unpackMove(packed, packed, u) == 0);
+    }
+
+}
+
+
+TEST_CASE("tests for MoveLogReaderT", "[MoveLog]") {
+
+    SECTION("games written can be read back and replayed") {
+        const char * path = "bin/testMoves.log";
+        {
+            MoveLogWriterT w(path);
+            w.write(617, MicrosoftDeal, playDeal(617, 40));
+            w.write(5, MicrosoftDeal, std::vector<MoveT>());
+            w.write(1ULL << 40, FastDeal, playDeal(1, 0));
+            w.close();
+        }
+
+        {
+            MoveLogReaderT log(path);
+            MoveLogRecordT r;
+            GameT g;
+            g.setJournaling(true);
+
+            REQUIRE(log.next(r));
+            REQUIRE(r.seed == 617);
+            REQUIRE(r.mode == MicrosoftDeal);
+            REQUIRE(r.length == 40);
+            REQUIRE(replay(r, g) == MoveOk);
+            REQUIRE(g.undoCount() == 40);
+            uint64_t h = g.hash();
+            REQUIRE(replay(r, g, false) == MoveOk);
+            REQUIRE(g.hash() == h);
+
+            REQUIRE(log.next(r));
+            REQUIRE(r.seed == 5);
+            REQUIRE(r.length == 0);
+            REQUIRE(replay(r, g) == MoveOk);
+            REQUIRE(g.hash() == GameT(5).hash());
+
+            REQUIRE(log.next(r));
+            REQUIRE(r.seed == 1ULL << 40);
+            REQUIRE(r.mode == FastDeal);
+            REQUIRE(!log.next(r));
+        }
+        std::remove(path);
+    }
+
+
+    SECTION("truncated logs throw io error") {
+        const char * path = "bin/testMoves.log";
+        {
+            MoveLogWriterT w(path);
+            w.write(617, MicrosoftDeal, playDeal(617, 10));
+        }
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out.put(0);
+        }
+
+        MoveLogReaderT log(path);
+        MoveLogRecordT r;
+        REQUIRE(log.next(r));
+        REQUIRE_THROWS_AS(log.next(r), io_error);
+        std::remove(path);
+    }
+
+
+    SECTION("records with an unknown kind of deal throw io error") {
+        const char * path = "bin/testMoves.log";
+        {
+            MoveLogWriterT w(path);
+            w.write(617, MicrosoftDeal, std::vector<MoveT>());
+            w.write(618, FastDeal, playDeal(618, 10));
+        }
+        {
+            // The first record has no moves, so the second starts after the
+            // 8 byte magic and one 13 byte header, with its deal kind.
+            std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+            io.seekp(8 + 13);
+            io.put(2);
+        }
+
+        MoveLogReaderT log(path);
+        MoveLogRecordT r;
+        REQUIRE(log.next(r));
+        REQUIRE(r.seed == 617);
+        REQUIRE_THROWS_AS(log.next(r), io_error);
+        std::remove(path);
+    }
+
+
+    SECTION("missing files throw io error") {
+        REQUIRE_THROWS_AS(MoveLogReaderT("bin/no such file"), io_error);
+    }
+
+}
+
+
+TEST_CASE("tests for replayMoves", "[MoveLog]") {
+
+    SECTION("validation stops at the first invalid move") {
+        std::vector<MoveT> played = playDeal(617, 10);
+        std::vector<unsigned char> packed;
+        for (MoveT m : played) {
+            unsigned char b[2];
+            packed.insert(packed.end(), b, b + packMove(m, b));
+        }
+        packMove(GameT::move(Foundation, 0, Cascade, 0), &packed[6]);
+
+        GameT g(617);
+        g.setJournaling(true);
+        unsigned long applied;
+        REQUIRE(replayMoves(g, packed.data(), packed.size(), true, applied) == MoveEmptySource);
+        REQUIRE(applied == 6);
+        REQUIRE(g.undoCount() == 6);
+    }
+
+
+    SECTION("supermoves replay") {
+        std::array<ColumnT, 16> cols;
+        for (unsigned int x = 0; x < 16; x++) {
+            cols[x] = ColumnT(x < 8 ? 19 : (x < 12 ? 1 : 13));
+        }
+        cols[0].push(CardT(Spades, King));
+        cols[0].push(CardT(Hearts, Queen));
+        cols[0].push(CardT(Clubs, Jack));
+        cols[1].push(CardT(Diamonds, King));
+
+        unsigned char packed[4];
+        unsigned int bytes = packMove(GameT::move(Cascade, 0, Cascade, 2, 3), packed);
+        bytes += packMove(GameT::move(Cascade, 2, Cascade, 0, 2), packed + bytes);
+        REQUIRE(bytes == 4);
+
+        GameT g(cols);
+        unsigned long applied;
+        REQUIRE(replayMoves(g, packed, bytes, true, applied) == MoveOk);
+        REQUIRE(applied == 2);
+        const GameT &cg = g;
+        REQUIRE(cg.getCol(Cascade, 0).size() == 2);
+        REQUIRE(cg.getCol(Cascade, 2).size() == 1);
+    }
+
+
+    SECTION("malformed escapes are rejected in both modes") {
+        unsigned char packed[] = { 0x33 };
+        GameT g(617);
+        g.setJournaling(true);
+        unsigned long applied;
+        REQUIRE(replayMoves(g, packed, 1, true, applied) == MoveInvalid);
+        REQUIRE(replayMoves(g, packed, 1, false, applied) == MoveInvalid);
+        REQUIRE(applied == 0);
+    }
+
+}
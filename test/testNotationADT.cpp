@@ -0,0 +1,243 @@
+#include "catch.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "NotationADT.h"
+#include "SolverADT.h"
+
+
+std::array<Stack<CardT>, 16> makeGame();
+
+
+static CardCodeT card(const std::string & s) {
+    return parseCard(s.data(), s.data() + s.size());
+}
+
+
+static MoveT move(const GameT & g, const std::string & s) {
+    return parseMove(g, s.data(), s.data() + s.size());
+}
+
+
+TEST_CASE("tests for card notation", "[Notation]") {
+
+    SECTION("cards parse") {
+        REQUIRE(card("KS") == packCard(Spades, King));
+        REQUIRE(card("AH") == packCard(Hearts, Ace));
+        REQUIRE(card("TD") == packCard(Diamonds, 10));
+        REQUIRE(card("10D") == packCard(Diamonds, 10));
+        REQUIRE(card("7C") == packCard(Clubs, 7));
+    }
+
+
+    SECTION("every card round trips") {
+        for (int s = 0; s < 4; s++) {
+            for (RankT r = Ace; r <= King; r++) {
+                std::string out;
+                formatCard(packCard(static_cast<SuitT>(s), r), out);
+                REQUIRE(out.size() == 2);
+                REQUIRE(card(out) == packCard(static_cast<SuitT>(s), r));
+            }
+        }
+    }
+
+
+    SECTION("malformed cards throw invalid notation") {
+        REQUIRE_THROWS_AS(card(""), invalid_notation);
+        REQUIRE_THROWS_AS(card("K"), invalid_notation);
+        REQUIRE_THROWS_AS(card("KX"), invalid_notation);
+        REQUIRE_THROWS_AS(card("1S"), invalid_notation);
+        REQUIRE_THROWS_AS(card("0S"), invalid_notation);
+        REQUIRE_THROWS_AS(card("KSS"), invalid_notation);
+    }
+
+}
+
+
+TEST_CASE("tests for move notation", "[Notation]") {
+
+    SECTION("moves parse to board columns") {
+        GameT g(617);
+        REQUIRE(move(g, "3a") == GameT::move(Cascade, 2, Cell, 0));
+        REQUIRE(move(g, "d8") == GameT::move(Cell, 3, Cascade, 7));
+        REQUIRE(move(g, "18") == GameT::move(Cascade, 0, Cascade, 7));
+        REQUIRE(move(g, "373") == GameT::move(Cascade, 2, Cascade, 6, 3));
+        REQUIRE(move(g, "3712") == GameT::move(Cascade, 2, Cascade, 6, 12));
+    }
+
+
+    SECTION("the foundation resolves to the one the move is valid for") {
+        GameT g(makeGame());
+        SolveResultT r = SolverT().solve(g);
+        REQUIRE(r.status == Solved);
+
+        for (MoveT m : r.moves) {
+            std::string out;
+            formatMove(m, out);
+            MoveT p = move(g, out);
+            REQUIRE(p.src() == m.src());
+            REQUIRE(g.tryMove(p) == MoveOk);
+        }
+        REQUIRE(g.hasWon());
+    }
+
+
+    SECTION("supermoves round trip") {
+        GameT g(617);
+        for (unsigned int n = 2; n <= 13; n++) {
+            std::string out;
+            formatMove(GameT::move(Cascade, 1, Cascade, 4, n), out);
+            REQUIRE(move(g, out) == GameT::move(Cascade, 1, Cascade, 4, n));
+        }
+    }
+
+
+    SECTION("malformed moves throw invalid notation") {
+        GameT g(617);
+        REQUIRE_THROWS_AS(move(g, "3"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "9a"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "ae"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "33"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "3ah"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "3a3"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "371"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "3714"), invalid_notation);
+        REQUIRE_THROWS_AS(move(g, "37x"), invalid_notation);
+    }
+
+
+    SECTION("move sequences round trip") {
+        GameT g(makeGame());
+        SolveResultT r = SolverT().solve(g);
+        std::string text;
+        formatMoves(r.moves, text);
+
+        std::vector<MoveT> parsed;
+        parseMoves(g, text, parsed);
+        REQUIRE(parsed.size() == r.moves.size());
+        for (MoveT m : parsed) {
+            g.performMove(GameT::placement(m.src()), GameT::position(m.src()), GameT::placement(m.dst()), GameT::position(m.dst()));
+        }
+        REQUIRE(g.hasWon());
+    }
+
+
+    SECTION("sequences with an invalid move throw invalid move") {
+        std::vector<MoveT> parsed;
+        REQUIRE_THROWS_AS(parseMoves(GameT(617), "1a 1a", parsed), invalid_move);
+        REQUIRE_THROWS_AS(parseMoves(GameT(617), "ah", parsed), invalid_move);
+    }
+
+}
+
+
+TEST_CASE("tests for board notation", "[Notation]") {
+
+    SECTION("dealt boards round trip") {
+        for (uint64_t n = 1; n <= 20; n++) {
+            std::string text;
+            formatBoard(GameT(n), text);
+            REQUIRE(parseBoard(text).hash() == GameT(n).hash());
+        }
+    }
+
+
+    SECTION("boards with cells and foundations round trip") {
+        GameT g(makeGame());
+        SolveResultT r = SolverT().solve(g);
+        for (unsigned int k = 0; k < r.moves.size() / 2; k++) {
+            g.tryMove(r.moves[k]);
+        }
+
+        std::string text;
+        formatBoard(g, text);
+        REQUIRE(parseBoard(text).canonicalHash() == g.canonicalHash());
+    }
+
+
+    SECTION("deal 1 parses from the common layout") {
+        GameT h = parseBoard(
+            "# deal 1\n"
+            ": JD KD 2S 4C 3S 6D 6S\n"
+            ": 2D KC KS 5C TD 8S 9C\n"
+            ": 9H 9S 9D TS 4S 8D 2H\n"
+            ": JC 5S QD QH TH QS 6H\n"
+            ": 5D AD JS 4H 8H 6C\n"
+            ": 7H QC AS AC 2C 3D\n"
+            ": 7C KH AH 4D JH 8C\n"
+            ": 5H 3H 3C 7S 7D TC\n"
+        );
+        REQUIRE(h.hash() == GameT(1).hash());
+    }
+
+
+    SECTION("incomplete boards throw") {
+        REQUIRE_THROWS_AS(parseBoard(": KS\n: QH\n"), invalid_notation);
+        std::string text;
+        formatBoard(GameT(1), text);
+        text.replace(text.find("JD"), 2, "TC");
+        REQUIRE_THROWS_AS(parseBoard(text), invalid_board);
+        REQUIRE_THROWS_AS(parseBoard("Freecells: KS QS JS TS 9S\n"), invalid_notation);
+    }
+
+}
+
+
+TEST_CASE("tests for BoardParserT", "[Notation]") {
+
+    SECTION("feeding a completed board throws invalid notation") {
+        std::string text;
+        formatBoard(GameT(1), text);
+        BoardParserT parser;
+        bool complete = false;
+        for (std::string::size_type p = 0, eol; p < text.size(); p = eol + 1) {
+            eol = text.find('\n', p);
+            complete = parser.feed(text.data() + p, text.data() + eol);
+        }
+        REQUIRE(complete);
+        REQUIRE_THROWS_AS(parser.feed(text.data(), text.data() + text.find('\n')), invalid_notation);
+        REQUIRE_THROWS_AS(parser.feed(text.data(), text.data()), invalid_notation);
+
+        REQUIRE(parser.game().hash() == GameT(1).hash());
+        REQUIRE(!parser.feed(text.data(), text.data()));
+    }
+
+}
+
+
+TEST_CASE("tests for BoardReaderT", "[Notation]") {
+
+    SECTION("boards stream out of a multi-deal file") {
+        std::string text;
+        for (uint64_t n = 1; n <= 5; n++) {
+            text += "# deal ";
+            text += static_cast<char>('0' + n);
+            text += '\n';
+            formatBoard(GameT(n), text);
+            text += '\n';
+        }
+
+        std::istringstream in(text);
+        BoardReaderT reader(in);
+        GameT g;
+        for (uint64_t n = 1; n <= 5; n++) {
+            REQUIRE(reader.next(g));
+            REQUIRE(g.hash() == GameT(n).hash());
+        }
+        REQUIRE(!reader.next(g));
+    }
+
+
+    SECTION("a truncated board throws invalid notation") {
+        std::istringstream in("Freecells: - - - -\n: KS\n");
+        BoardReaderT reader(in);
+        GameT g;
+        REQUIRE_THROWS_AS(reader.next(g), invalid_notation);
+    }
+
+}
@@ -0,0 +1,169 @@
+#include "catch.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "PositionDbADT.h"
+#include "SolverADT.h"
+
+
+std::array<Stack<CardT>, 16> makeGame();
+
+
+TEST_CASE("tests for BestMoveT", "[PositionDb]") {
+
+    SECTION("a described move resolves to itself") {
+        const GameT g(617);
+        MoveBuffer moves;
+        g.generateMoves(moves);
+        for (MoveT m : moves) {
+            MoveT r;
+            REQUIRE(resolveMove(g, describeMove(g, m), r));
+            REQUIRE(r.src() == m.src());
+            REQUIRE(g.getCol(GameT::placement(r.dst()), GameT::position(r.dst())).size() ==
+                    g.getCol(GameT::placement(m.dst()), GameT::position(m.dst())).size());
+        }
+    }
+
+
+    SECTION("a described move resolves on a permuted board") {
+        std::array<Stack<CardT>, 16> cols = makeGame();
+        GameT g(cols);
+        std::swap(cols[0], cols[5]);
+        GameT h(cols);
+        REQUIRE(g.canonicalHash() == h.canonicalHash());
+
+        MoveBuffer moves;
+        g.generateMoves(moves);
+        MoveT r;
+        REQUIRE(resolveMove(h, describeMove(g, moves[0]), r));
+        REQUIRE(h.checkMove(GameT::placement(r.src()), GameT::position(r.src()), GameT::placement(r.dst()), GameT::position(r.dst())) == MoveOk);
+    }
+
+
+    SECTION("a move for another board does not resolve") {
+        BestMoveT b = { packCard(Hearts, 9), Cascade, packCard(Hearts, 10) };
+        MoveT r;
+        REQUIRE(!resolveMove(GameT(617), b, r));
+    }
+
+}
+
+
+TEST_CASE("tests for PositionDbT", "[PositionDb]") {
+
+    SECTION("following stored best moves wins the game") {
+        const char * path = "bin/testPositions.db";
+        GameT g(makeGame());
+        SolveResultT r = SolverT().solve(g);
+        REQUIRE(r.status == Solved);
+
+        PositionDbBuilderT b;
+        b.addSolution(g, r.moves);
+        REQUIRE(b.size() > 0);
+        b.write(path);
+
+        {
+            PositionDbT db(path);
+            REQUIRE(db.size() == b.size());
+
+            PositionInfoT info;
+            REQUIRE(db.lookup(g, info));
+            REQUIRE(info.winnable);
+            REQUIRE(info.distance <= r.moves.size());
+
+            while (!g.hasWon()) {
+                REQUIRE(db.lookup(g, info));
+                MoveT m;
+                REQUIRE(resolveMove(g, info.best, m));
+                REQUIRE(g.tryMove(m) == MoveOk);
+            }
+            REQUIRE(db.lookup(g, info));
+            REQUIRE(info.distance == 0);
+            REQUIRE(!db.lookup(GameT(617), info));
+        }
+        std::remove(path);
+    }
+
+
+    SECTION("merging keeps the better record") {
+        const char * path = "bin/testPositions.db";
+        PositionInfoT lost = { false, 0, BestMoveT() };
+        PositionInfoT far = { true, 40, BestMoveT() };
+        PositionInfoT near = { true, 12, BestMoveT() };
+
+        PositionDbBuilderT a;
+        a.add(1, lost);
+        a.add(2, near);
+        a.add(3, lost);
+        a.write(path);
+
+        PositionDbBuilderT b;
+        b.add(1, far);
+        b.add(2, far);
+        {
+            PositionDbT db(path);
+            b.merge(db);
+        }
+        REQUIRE(b.size() == 3);
+        b.write(path);
+
+        {
+            PositionDbT db(path);
+            PositionInfoT info;
+            REQUIRE(db.lookup(1, info));
+            REQUIRE(info.winnable);
+            REQUIRE(info.distance == 40);
+            REQUIRE(db.lookup(2, info));
+            REQUIRE(info.distance == 12);
+            REQUIRE(db.lookup(3, info));
+            REQUIRE(!info.winnable);
+            REQUIRE(!db.lookup(4, info));
+        }
+        std::remove(path);
+    }
+
+
+    SECTION("missing or malformed files throw io error") {
+        REQUIRE_THROWS_AS(PositionDbT("bin/no such file"), io_error);
+
+        const char * path = "bin/testPositions.db";
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "not a position database, just some bytes";
+        }
+        REQUIRE_THROWS_AS(PositionDbT(path), io_error);
+        std::remove(path);
+    }
+
+
+    SECTION("lookups end on a table with no empty slot") {
+        // Two slots, both in use: a file the builder never writes.
+        const char * path = "bin/testPositions.db";
+        unsigned char bytes[32 + 2 * 16] = { 'F', 'C', 'P', 'O', 'S', 'D', 'B', '1' };
+        uint64_t slots = 2;
+        uint64_t keys[2] = { 4, 7 };
+        std::memcpy(bytes + 8, &slots, sizeof(slots));
+        std::memcpy(bytes + 16, &slots, sizeof(slots));
+        std::memcpy(bytes + 32, &keys[0], sizeof(keys[0]));
+        std::memcpy(bytes + 48, &keys[1], sizeof(keys[1]));
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+        }
+
+        {
+            PositionDbT db(path);
+            PositionInfoT info;
+            REQUIRE(db.lookup(7, info));
+            REQUIRE(!db.lookup(8, info));
+            REQUIRE(!db.lookup(9, info));
+        }
+        std::remove(path);
+    }
+
+}
@@ -0,0 +1,105 @@
+#include "catch.h"
+
+#include <cstdio>
+
+#include "Exceptions.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "SnapshotADT.h"
+
+
+std::array<Stack<CardT>, 16> makeGameEmptyCascade();
+
+
+TEST_CASE("tests for SnapshotViewT", "[Snapshot]") {
+
+    SECTION("snapshot round trips through GameT") {
+        GameT g(617);
+        MoveBuffer moves;
+        for (int k = 0; k < 3; k++) {
+            g.generateMoves(moves);
+            REQUIRE(g.tryMove(moves[moves.size() - 1]) == MoveOk);
+        }
+        SnapshotT s = g.snapshot();
+        GameT h((SnapshotViewT(s)));
+        REQUIRE(h.hash() == g.hash());
+    }
+
+
+    SECTION("view reads columns in place") {
+        GameT g(1);
+        g.performMove(Cascade, 3, Cell, 1);
+        SnapshotT s = g.snapshot();
+        SnapshotViewT v(s);
+        REQUIRE(v.data() == s.data());
+        REQUIRE(v.length(0) == 7);
+        REQUIRE(v.length(3) == 6);
+        REQUIRE(v.length(9) == 1);
+        REQUIRE(v.length(12) == 0);
+        const GameT &cg = g;
+        REQUIRE(v.card(0, 0) == cg.getCol(Cascade, 0).begin()->code());
+        REQUIRE(v.top(3) == cg.getCol(Cascade, 3).peek().code());
+        REQUIRE(v.top(9) == cg.getCol(Cell, 1).peek().code());
+    }
+
+
+    SECTION("malformed snapshots throw invalid board") {
+        SnapshotT s = GameT(1).snapshot();
+        s[8] = 2;
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+        s[8] = 1;
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+    }
+
+
+    SECTION("snapshots with bad cards throw invalid board") {
+        SnapshotT s = GameT(1).snapshot();
+        s[16] = 200;
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+        s[16] = 0x0E;
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+        s[16] = 0x30;
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+        s[16] = s[17];
+        REQUIRE_THROWS_AS(GameT((SnapshotViewT(s))), invalid_board);
+    }
+
+
+    SECTION("snapshot of an incomplete board throws invalid board") {
+        std::array<Stack<CardT>, 16> cols = makeGameEmptyCascade();
+        cols[12].pop();
+        GameT g(cols);
+        REQUIRE_THROWS_AS(g.snapshot(), invalid_board);
+    }
+
+}
+
+
+TEST_CASE("tests for SnapshotFileT", "[Snapshot]") {
+
+    SECTION("snapshots written can be read back by mapping") {
+        const char * path = "bin/testSnapshots.bin";
+        {
+            SnapshotWriterT w(path);
+            for (uint64_t n = 1; n <= 10; n++) {
+                w.write(GameT(n).snapshot());
+            }
+            w.close();
+        }
+
+        {
+            SnapshotFileT f(path);
+            REQUIRE(f.size() == 10);
+            for (uint64_t n = 1; n <= 10; n++) {
+                REQUIRE(GameT(f[n - 1]).hash() == GameT(n).hash());
+            }
+        }
+        std::remove(path);
+    }
+
+
+    SECTION("missing files throw io error") {
+        REQUIRE_THROWS_AS(SnapshotFileT("bin/no such file"), io_error);
+    }
+
+}
@@ -0,0 +1,185 @@
+#include "catch.h"
+
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "SolverADT.h"
+
+
+std::array<Stack<CardT>, 16> makeGame();
+std::array<Stack<CardT>, 16> makeGameNoMoves();
+std::array<Stack<CardT>, 16> makeGameWon();
+
+
+TEST_CASE("tests for SolverT", "[SolverT]") {
+
+    SECTION("heuristics on a won game") {
+        GameT g(makeGameWon());
+        REQUIRE(cardsOutside(g) == 0);
+        REQUIRE(cardsOutsideAndBlocking(g) == 0);
+    }
+
+
+    SECTION("heuristics on a dealt game") {
+        GameT g(makeGame());
+        REQUIRE(cardsOutside(g) == 52);
+        REQUIRE(cardsOutsideAndBlocking(g) > 52);
+    }
+
+
+    SECTION("solve finds a winning sequence of moves") {
+        SolverT s;
+        GameT g(makeGame());
+        SolveResultT r = s.solve(g);
+        REQUIRE(r.status == Solved);
+        REQUIRE(!r.moves.empty());
+        REQUIRE(r.nodes > 0);
+
+        for (MoveT m : r.moves) {
+            g.performMove(GameT::placement(m.src()), GameT::position(m.src()), GameT::placement(m.dst()), GameT::position(m.dst()));
+        }
+        REQUIRE(g.hasWon());
+    }
+
+
+    SECTION("solve with supermoves finds a winning sequence of moves") {
+        SolverConfigT config;
+        config.supermoves = true;
+        GameT g(makeGame());
+        SolveResultT r = SolverT(config).solve(g);
+        REQUIRE(r.status == Solved);
+
+        for (MoveT m : r.moves) {
+            g.performMove(m);
+        }
+        REQUIRE(g.hasWon());
+    }
+
+
+    SECTION("solve without autoplay finds a winning sequence of moves") {
+        SolverConfigT config;
+        config.autoplay = false;
+        GameT g(makeGame());
+        SolveResultT r = SolverT(config).solve(g);
+        REQUIRE(r.status == Solved);
+
+        for (MoveT m : r.moves) {
+            g.performMove(m);
+        }
+        REQUIRE(g.hasWon());
+    }
+
+
+    SECTION("solve on a won game needs no moves") {
+        SolverT s;
+        SolveResultT r = s.solve(GameT(makeGameWon()));
+        REQUIRE(r.status == Solved);
+        REQUIRE(r.moves.empty());
+    }
+
+
+    SECTION("solve reports an unsolvable game") {
+        SolverT s;
+        SolveResultT r = s.solve(GameT(makeGameNoMoves()));
+        REQUIRE(r.status == Unsolvable);
+        REQUIRE(r.nodes == 1);
+    }
+
+
+    SECTION("solve stops at the node budget") {
+        SolverConfigT config;
+        config.maxNodes = 10;
+        SolverT s(config);
+        SolveResultT r = s.solve(GameT(makeGame()));
+        REQUIRE(r.status == NodeLimit);
+        REQUIRE(r.nodes == 10);
+    }
+
+
+    SECTION("a power-of-two node budget fills the table exactly") {
+        // The table then holds exactly the budget, so it fills up on the
+        // same state that reaches the budget.
+        SolverConfigT config;
+        config.maxNodes = 1024;
+        SolverT s(config);
+        for (uint64_t seed : { 1, 3 }) {
+            SolveResultT r = s.solve(GameT(seed));
+            REQUIRE(r.status != Unsolvable);
+            REQUIRE(r.nodes <= 1024);
+        }
+    }
+
+
+    SECTION("a solver can be reused") {
+        SolverT s;
+        GameT g(makeGame());
+        SolveResultT a = s.solve(g);
+        SolveResultT b = s.solve(g);
+        REQUIRE(a.status == Solved);
+        REQUIRE(b.moves.size() == a.moves.size());
+        REQUIRE(b.nodes == a.nodes);
+    }
+
+}
+
+
+TEST_CASE("tests for ParallelSolverT", "[SolverT]") {
+
+    SECTION("thread count follows the configuration") {
+        SolverConfigT config;
+        config.threads = 3;
+        ParallelSolverT s(config);
+        REQUIRE(s.threads() == 3);
+        REQUIRE(ParallelSolverT().threads() >= 1);
+    }
+
+
+    SECTION("solve finds a winning sequence of moves") {
+        for (unsigned int threads : { 1, 4 }) {
+            SolverConfigT config;
+            config.threads = threads;
+            ParallelSolverT s(config);
+            GameT g(makeGame());
+            SolveResultT r = s.solve(g);
+            REQUIRE(r.status == Solved);
+
+            for (MoveT m : r.moves) {
+                g.performMove(GameT::placement(m.src()), GameT::position(m.src()), GameT::placement(m.dst()), GameT::position(m.dst()));
+            }
+            REQUIRE(g.hasWon());
+        }
+    }
+
+
+    SECTION("solve reports an unsolvable game") {
+        SolverConfigT config;
+        config.threads = 4;
+        ParallelSolverT s(config);
+        SolveResultT r = s.solve(GameT(makeGameNoMoves()));
+        REQUIRE(r.status == Unsolvable);
+    }
+
+
+    SECTION("solve stops at the node budget") {
+        SolverConfigT config;
+        config.threads = 2;
+        config.maxNodes = 10;
+        ParallelSolverT s(config);
+        SolveResultT r = s.solve(GameT(makeGame()));
+        REQUIRE(r.status == NodeLimit);
+        REQUIRE(r.nodes == 10);
+    }
+
+
+    SECTION("a power-of-two node budget fills the table exactly") {
+        SolverConfigT config;
+        config.threads = 2;
+        config.maxNodes = 1024;
+        ParallelSolverT s(config);
+        for (uint64_t seed : { 1, 3 }) {
+            SolveResultT r = s.solve(GameT(seed));
+            REQUIRE(r.status != Unsolvable);
+            REQUIRE(r.nodes <= 1024);
+        }
+    }
+
+}
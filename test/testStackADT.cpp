@@ -1,5 +1,6 @@
 #include "catch.h"
 
+#include "CardADT.h"
 #include "Exceptions.h"
 #include "StackADT.h"
 
@@ -45,6 +46,17 @@ TEST_CASE("tests for Stack", "[Stack]") {
     }
 
 
+    SECTION("size counts items") {
+        Stack<int> s(2);
+        REQUIRE(s.size() == 0);
+        s.push(1);
+        s.push(2);
+        REQUIRE(s.size() == 2);
+        s.pop();
+        REQUIRE(s.size() == 1);
+    }
+
+
     SECTION("is full returns false") {
         Stack<int> s(1);
         REQUIRE(!s.isFull());
@@ -88,6 +100,16 @@ TEST_CASE("tests for Stack", "[Stack]") {
     }
 
 
+    SECTION("begin and end span the members") {
+        Stack<int> s(2);
+        REQUIRE(s.begin() == s.end());
+        s.push(1);
+        s.push(2);
+        REQUIRE(s.end() - s.begin() == 2);
+        REQUIRE(*s.begin() == 1);
+    }
+
+
     SECTION("seq returns new sequence") {
         Stack<int> s(2);
         s.push(1);
@@ -99,3 +121,64 @@ TEST_CASE("tests for Stack", "[Stack]") {
     }
 
 }
+
+
+TEST_CASE("tests for inline Stack", "[Stack]") {
+
+    SECTION("bounded constructor within inline bound") {
+        Stack<CardT, 19> s(13);
+        REQUIRE(s.capacity() == 13);
+        REQUIRE(s.isEmpty());
+    }
+
+
+    SECTION("invalid capacity beyond inline bound") {
+        REQUIRE_THROWS_AS(
+            (Stack<CardT, 19>(20)),
+            invalid_capacity
+        );
+        REQUIRE_THROWS_AS(
+            (Stack<CardT, 19>(0)),
+            invalid_capacity
+        );
+    }
+
+
+    SECTION("push, peek, and pop maintain FILO ordering") {
+        Stack<CardT, 19> s(2);
+        s.push(CardT(Spades, Ace));
+        s.push(CardT(Hearts, 2));
+        REQUIRE(s.isFull());
+        REQUIRE_THROWS_AS(s.push(CardT(Clubs, 3)), full);
+        REQUIRE(s.peek().suit() == Hearts);
+        s.pop();
+        REQUIRE(s.peek().suit() == Spades);
+        s.pop();
+        REQUIRE(s.isEmpty());
+        REQUIRE_THROWS_AS(s.pop(), empty);
+    }
+
+
+    SECTION("iterates over members in insertion order") {
+        Stack<CardT, 19> s(3);
+        s.push(CardT(Spades, Ace));
+        s.push(CardT(Hearts, 2));
+        RankT r = Ace;
+        for (CardT c : s) {
+            REQUIRE(c.rank() == r++);
+        }
+        REQUIRE(s.end() - s.begin() == 2);
+    }
+
+
+    SECTION("copies are independent") {
+        Stack<CardT, 19> s(2);
+        s.push(CardT(Spades, Ace));
+        Stack<CardT, 19> t = s;
+        t.pop();
+        REQUIRE(!s.isEmpty());
+        REQUIRE(t.isEmpty());
+        REQUIRE(s.seq().size() == 1);
+    }
+
+}
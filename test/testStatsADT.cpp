@@ -0,0 +1,114 @@
+#include "catch.h"
+
+#include <string>
+#include <vector>
+
+#include "CardADT.h"
+#include "GameADT.h"
+#include "GameTypes.h"
+#include "StackADT.h"
+#include "StatsADT.h"
+
+
+TEST_CASE("tests for StatsT", "[Stats]") {
+
+    SECTION("stats count calls and allocations when enabled") {
+        resetStats();
+        Stack<CardT> s(4);
+        s.push(CardT(Spades, Ace));
+        s.push(CardT(Hearts, 2));
+        REQUIRE(s.peek().rank() == 2);
+        std::vector<CardT> cards = s.seq();
+        s.pop();
+
+        StatsT st = stats();
+        if (statsEnabled()) {
+            REQUIRE(st[StatStackPush].calls == 2);
+            REQUIRE(st[StatStackPush].allocations >= 1);
+            REQUIRE(st[StatStackPeek].calls == 1);
+            REQUIRE(st[StatStackPop].calls == 1);
+            REQUIRE(st[StatStackSeq].calls == 1);
+            REQUIRE(st[StatStackSeq].allocations == 1);
+            REQUIRE(st[StatStackSeq].bytes == 2 * sizeof(CardT));
+        } else {
+            REQUIRE(st.total().calls == 0);
+        }
+    }
+
+
+    SECTION("inline stacks do not allocate") {
+        resetStats();
+        ColumnT col(19);
+        for (int r = King; r >= Ace; r--) {
+            col.push(CardT(Clubs, static_cast<RankT>(r)));
+        }
+        REQUIRE(stats()[StatStackPush].allocations == 0);
+        REQUIRE(stats()[StatStackPush].calls == (statsEnabled() ? 13u : 0u));
+    }
+
+
+    SECTION("allocations are charged to the outermost call") {
+        GameT g(617);
+        g.setJournaling(true);
+        MoveBuffer moves;
+        g.generateMoves(moves);
+
+        resetStats();
+        g.performMove(moves[0]);
+        std::vector<MoveT> h;
+        g.history(h);
+
+        StatsT st = stats();
+        if (statsEnabled()) {
+            REQUIRE(st[StatGamePerformMove].calls == 1);
+            REQUIRE(st[StatGameTryMove].calls == 1);
+            REQUIRE(st[StatGameCheckMove].calls == 1);
+            REQUIRE(st[StatGamePerformMove].allocations == 1);
+            REQUIRE(st[StatGameTryMove].allocations == 0);
+            REQUIRE(st[StatGameHistory].allocations == 1);
+            REQUIRE(st[StatGameHistory].bytes == sizeof(MoveT));
+            REQUIRE(st.total().allocations == 2);
+        } else {
+            REQUIRE(st.total().allocations == 0);
+        }
+
+        resetStats();
+        REQUIRE(stats().total().calls == 0);
+    }
+
+
+    SECTION("copies are counted, and only a journal allocates") {
+        GameT g(617);
+        resetStats();
+        GameT h(g);
+        h = g;
+
+        StatsT st = stats();
+        if (statsEnabled()) {
+            REQUIRE(st[StatGameCopyConstruct].calls == 1);
+            REQUIRE(st[StatGameCopyAssign].calls == 1);
+            REQUIRE(st[StatGameConstruct].calls == 0);
+            REQUIRE(st.total().allocations == 0);
+        }
+
+        MoveBuffer moves;
+        g.generateMoves(moves);
+        g.setJournaling(true);
+        g.performMove(moves[0]);
+        resetStats();
+        GameT j(g);
+        if (statsEnabled()) {
+            REQUIRE(stats()[StatGameCopyConstruct].allocations == 1);
+        }
+        REQUIRE(j.undoCount() == 1);
+    }
+
+
+    SECTION("every API call has a name") {
+        for (int a = 0; a < StatApiCount; a++) {
+            REQUIRE(statName(static_cast<StatApiT>(a))[0] != '\0');
+        }
+        REQUIRE(std::string(statName(StatGamePerformMove)) == "GameT::performMove");
+    }
+
+}
@@ -0,0 +1,101 @@
+#include "catch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Exceptions.h"
+#include "TranspositionADT.h"
+
+
+TEST_CASE("tests for TranspositionTableT", "[TranspositionTableT]") {
+
+    SECTION("invalid capacity") {
+        REQUIRE_THROWS_AS(TranspositionTableT(0), invalid_capacity);
+    }
+
+
+    SECTION("insert reports new hashes only") {
+        TranspositionTableT t(4);
+        REQUIRE(t.insert(42) == InsertOk);
+        REQUIRE(t.insert(42) == InsertDuplicate);
+        REQUIRE(t.insert(0) == InsertOk);
+        REQUIRE(t.contains(42));
+        REQUIRE(t.contains(0));
+        REQUIRE(!t.contains(7));
+        REQUIRE(t.size() == 2);
+    }
+
+
+    SECTION("insert fails once full") {
+        TranspositionTableT t(2);
+        unsigned long n = 0;
+        for (uint64_t h = 1; h <= 100; h++) {
+            n += t.insert(h * 0x9e3779b97f4a7c15ULL) == InsertOk;
+        }
+        REQUIRE(n == t.capacity());
+        REQUIRE(t.capacity() >= 2);
+        // A full table still tells hashes it holds from new ones.
+        REQUIRE(t.insert(0x9e3779b97f4a7c15ULL) == InsertDuplicate);
+        REQUIRE(t.insert(100 * 0x9e3779b97f4a7c15ULL) == InsertFull);
+    }
+
+
+    SECTION("clear empties the table") {
+        TranspositionTableT t(4);
+        t.insert(1);
+        t.clear();
+        REQUIRE(t.size() == 0);
+        REQUIRE(!t.contains(1));
+        REQUIRE(t.insert(1) == InsertOk);
+    }
+
+}
+
+
+TEST_CASE("tests for ConcurrentTranspositionTableT", "[TranspositionTableT]") {
+
+    SECTION("insert reports new hashes only") {
+        ConcurrentTranspositionTableT t(4);
+        REQUIRE(t.insert(42) == InsertOk);
+        REQUIRE(t.insert(42) == InsertDuplicate);
+        REQUIRE(t.insert(0) == InsertOk);
+        REQUIRE(t.contains(0));
+        REQUIRE(!t.contains(7));
+        REQUIRE(t.size() == 2);
+        t.clear();
+        REQUIRE(!t.contains(42));
+    }
+
+
+    SECTION("each hash is added by exactly one thread") {
+        ConcurrentTranspositionTableT t(4000);
+        std::atomic<unsigned long> added(0);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < 4; w++) {
+            threads.push_back(std::thread([&]() {
+                for (uint64_t h = 1; h <= 1000; h++) {
+                    added += t.insert(h * 0x9e3779b97f4a7c15ULL) == InsertOk;
+                }
+            }));
+        }
+        for (std::thread &th : threads) {
+            th.join();
+        }
+        REQUIRE(added.load() == 1000);
+        REQUIRE(t.size() == 1000);
+    }
+
+
+    SECTION("insert fails once full") {
+        ConcurrentTranspositionTableT t(2);
+        unsigned long n = 0;
+        for (uint64_t h = 1; h <= 100; h++) {
+            n += t.insert(h * 0x9e3779b97f4a7c15ULL) == InsertOk;
+        }
+        REQUIRE(n == t.capacity());
+        REQUIRE(t.insert(0x9e3779b97f4a7c15ULL) == InsertDuplicate);
+        REQUIRE(t.insert(100 * 0x9e3779b97f4a7c15ULL) == InsertFull);
+    }
+
+}